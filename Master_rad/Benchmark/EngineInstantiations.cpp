@@ -0,0 +1,35 @@
+#include "../Prim.cpp"
+#include "../Kruskal.cpp"
+#include "../Boruvka.cpp"
+#include "../Generators/CSRGraph.hpp"
+#include "../Generators/CompressedCSR.hpp"
+
+#include <cstdint>
+
+// the only instantiations of the templated engines, Engines.hpp declares them extern
+// a new weight or id type is added here and in Engines.hpp
+
+template class PrimsAlgorithm<int, int>;
+template class PrimsAlgorithm<int, long long>;
+template class PrimsAlgorithm<std::uint16_t, int>;
+template class PrimsAlgorithm<std::uint32_t, int>;
+template class PrimsAlgorithm<float, int>;
+template class PrimsAlgorithm<double, int>;
+template class PrimsAlgorithm<int, int, mstgen::CompressedCSR>;
+template class PrimsAlgorithm<int, int, mstgen::CSRView>;
+
+template class KruskalAlgorithm<int, int>;
+template class KruskalAlgorithm<int, long long>;
+template class KruskalAlgorithm<std::uint16_t, int>;
+template class KruskalAlgorithm<std::uint32_t, int>;
+template class KruskalAlgorithm<float, int>;
+template class KruskalAlgorithm<double, int>;
+
+template class BoruvkaAlgorithm<int, int>;
+template class BoruvkaAlgorithm<int, long long>;
+template class BoruvkaAlgorithm<std::uint16_t, int>;
+template class BoruvkaAlgorithm<std::uint32_t, int>;
+template class BoruvkaAlgorithm<float, int>;
+template class BoruvkaAlgorithm<double, int>;
+template class BoruvkaAlgorithm<int, int, mstgen::CompressedCSR>;
+template class BoruvkaAlgorithm<int, int, mstgen::CSRView>;
@@ -0,0 +1,337 @@
+#pragma once
+
+#include "../Prim.cpp"
+#include "../Kruskal.cpp"
+#include "../Boruvka.cpp"
+#include "../ReverseDelete.cpp"
+#include "../Karger/Karger.cpp"
+#include "../FredmanTarjan/FredmanTarjan.cpp"
+#include "../Chazelle/Chazelle.cpp"
+#include "../ExternalKruskal.cpp"
+#include "../StreamingMSF.cpp"
+
+#include "../GenerateGraph.hpp"
+#include "../Generators/CSRGraph.hpp"
+#include "../Generators/CompressedCSR.hpp"
+#include "../Generators/GraphFamilies.hpp"
+#include "../Utils/MSTResult.h"
+#include "../Utils/MSTEngine.h"
+#include "Options.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// the templated engines are instantiated once, in EngineInstantiations.cpp
+extern template class PrimsAlgorithm<int, int>;
+extern template class PrimsAlgorithm<int, long long>;
+extern template class PrimsAlgorithm<std::uint16_t, int>;
+extern template class PrimsAlgorithm<std::uint32_t, int>;
+extern template class PrimsAlgorithm<float, int>;
+extern template class PrimsAlgorithm<double, int>;
+extern template class PrimsAlgorithm<int, int, mstgen::CompressedCSR>;
+extern template class PrimsAlgorithm<int, int, mstgen::CSRView>;
+
+extern template class KruskalAlgorithm<int, int>;
+extern template class KruskalAlgorithm<int, long long>;
+extern template class KruskalAlgorithm<std::uint16_t, int>;
+extern template class KruskalAlgorithm<std::uint32_t, int>;
+extern template class KruskalAlgorithm<float, int>;
+extern template class KruskalAlgorithm<double, int>;
+
+extern template class BoruvkaAlgorithm<int, int>;
+extern template class BoruvkaAlgorithm<int, long long>;
+extern template class BoruvkaAlgorithm<std::uint16_t, int>;
+extern template class BoruvkaAlgorithm<std::uint32_t, int>;
+extern template class BoruvkaAlgorithm<float, int>;
+extern template class BoruvkaAlgorithm<double, int>;
+extern template class BoruvkaAlgorithm<int, int, mstgen::CompressedCSR>;
+extern template class BoruvkaAlgorithm<int, int, mstgen::CSRView>;
+
+// registry of the MST engines that can be benchmarked
+// a new engine is added to the list in engines() (or with registerEngine), main.cpp doesn't have to be changed
+
+namespace mstbench {
+
+    // result of one run of an engine
+    struct EngineRun {
+        // double, so that floating point weights fit
+        double weight{ 0 };
+        // total time, the sum of the phases
+        double ms{ 0 };
+        PhaseTimes phases{};
+        // number of nodes, reported by the streaming engines which learn it from the file
+        std::size_t nodes{ 0 };
+    };
+
+    // called around prepare and solve of a run, so the memory and the hardware counters cover the same part as the timer,
+    // without the copies of the graph some engines make first (the typed, compressed or CSR graph, the copy of a mutated input)
+    struct RunHooks {
+        std::function<void()> start{};
+        std::function<void()> stop{};
+    };
+
+    template<typename Solve>
+    void measured(const RunHooks* hooks, Solve solve) {
+        if (hooks && hooks->start) hooks->start();
+        solve();
+        if (hooks && hooks->stop) hooks->stop();
+    }
+
+    struct Engine {
+        std::string name;
+        // runs the engine on the graph, the engine is allowed to change the graph
+        // the MST is copied to the result after the timed run if it's not null, the hooks (can be null) wrap prepare and solve
+        std::function<EngineRun(mstgen::AdjList&, MSTResult<>*, const RunHooks*)> run;
+        // the biggest n the engine is run on unless limits are disabled, 0 means no limit
+        std::size_t maxN{ 0 };
+        // engines run when the algorithms are not chosen explicitly
+        bool byDefault{ true };
+        // the engine changes the graph, so it has to get its own copy when the graph is shared
+        bool mutatesInput{ false };
+        // a new MSTEngine that can be kept and used for many graphs, empty for the engines that convert the graph first
+        std::function<std::unique_ptr<MSTEngine>()> create{};
+        // runs the engine on CSR arrays in place (e.g. the memory-mapped input) without building the adjacency list,
+        // empty for the engines that need the adjacency list
+        std::function<EngineRun(mstgen::CSRView&, MSTResult<>*, const RunHooks*)> runView{};
+    };
+
+    // engines follow the same pattern: prepare binds the graph, solve does the work, weight and time are read afterwards
+    template<typename Algorithm>
+    EngineRun runAlgorithm(mstgen::AdjList& adjacencyList, MSTResult<>* result, const RunHooks* hooks) {
+        Algorithm algorithm;
+        measured(hooks, [&] {
+            algorithm.prepare(adjacencyList);
+            algorithm.solve();
+        });
+        if (result) *result = algorithm.getResult();
+        return { static_cast<double>(algorithm.getMSTWeight()), algorithm.getDuration(), algorithm.getPhaseTimes() };
+    }
+
+    // runs the engine on a copy of the graph with other weight and id types, the copy is made before the engine starts timing
+    template<typename Algorithm, typename Weight, typename Index = int>
+    EngineRun runTypedAlgorithm(mstgen::AdjList& adjacencyList, MSTResult<>* result, const RunHooks* hooks) {
+        WeightedAdjacencyList<Weight, Index> typed(adjacencyList.size());
+        for (std::size_t u = 0; u < adjacencyList.size(); ++u) {
+            typed[u].reserve(adjacencyList[u].size());
+            for (const auto& [v, weight] : adjacencyList[u]) {
+                if constexpr (std::is_integral_v<Weight>) {
+                    if (!std::in_range<Weight>(weight)) throw std::runtime_error("weight " + std::to_string(weight) + " doesn't fit the weight type of the engine");
+                }
+                typed[u].push_back({ static_cast<Index>(v), static_cast<Weight>(weight) });
+            }
+        }
+        Algorithm algorithm;
+        measured(hooks, [&] {
+            algorithm.prepare(typed);
+            algorithm.solve();
+        });
+        if (result) {
+            // the weights came from the int graph, so they convert back exactly
+            auto typedResult = algorithm.getResult();
+            std::vector<MSTEdge<>> edges;
+            edges.reserve(typedResult.edges.size());
+            for (const auto& edge : typedResult.edges) {
+                edges.push_back({ static_cast<int>(edge.u), static_cast<int>(edge.v), static_cast<int>(edge.weight), edge.id });
+            }
+            *result = buildMSTResult(adjacencyList.size(), std::move(edges));
+        }
+        return { static_cast<double>(algorithm.getMSTWeight()), algorithm.getDuration(), algorithm.getPhaseTimes() };
+    }
+
+    // runs the engine on the compressed copy of the graph (Generators/CompressedCSR.hpp), the compression is not timed
+    template<typename Algorithm>
+    EngineRun runCompressedAlgorithm(mstgen::AdjList& adjacencyList, MSTResult<>* result, const RunHooks* hooks) {
+        auto compressed = mstgen::compress(adjacencyList);
+        Algorithm algorithm;
+        measured(hooks, [&] {
+            algorithm.prepare(compressed);
+            algorithm.solve();
+        });
+        if (result) {
+            // the compressed lists are sorted, the ids are those of the original lists
+            std::vector<MSTEdge<>> edges;
+            algorithm.forEachMSTEdge([&](int u, int v, int weight) { edges.push_back({ u, v, weight, noEdgeId }); });
+            assignEdgeIds(adjacencyList, edges);
+            *result = buildMSTResult(adjacencyList.size(), std::move(edges));
+        }
+        return { static_cast<double>(algorithm.getMSTWeight()), algorithm.getDuration(), algorithm.getPhaseTimes() };
+    }
+
+    // runs the engine directly on the CSR arrays, the ids are those of the adjacency list with the same order of the lists
+    template<typename Algorithm>
+    EngineRun runViewAlgorithm(mstgen::CSRView& graph, MSTResult<>* result, const RunHooks* hooks) {
+        Algorithm algorithm;
+        measured(hooks, [&] {
+            algorithm.prepare(graph);
+            algorithm.solve();
+        });
+        if (result) {
+            std::vector<MSTEdge<>> edges;
+            algorithm.forEachMSTEdge([&](int u, int v, int weight) { edges.push_back({ u, v, weight, noEdgeId }); });
+            assignEdgeIds(graph, edges);
+            *result = buildMSTResult(graph.nodesNumber(), std::move(edges));
+        }
+        return { static_cast<double>(algorithm.getMSTWeight()), algorithm.getDuration(), algorithm.getPhaseTimes() };
+    }
+
+    // runs the engine on the CSR copy of the graph, the copy is not timed
+    template<typename Algorithm>
+    EngineRun runCSRAlgorithm(mstgen::AdjList& adjacencyList, MSTResult<>* result, const RunHooks* hooks) {
+        auto csr = mstgen::to_csr(adjacencyList);
+        auto graph = mstgen::view(csr);
+        return runViewAlgorithm<Algorithm>(graph, result, hooks);
+    }
+
+    template<typename Algorithm>
+    std::unique_ptr<MSTEngine> createEngine() {
+        return std::make_unique<AlgorithmEngine<Algorithm>>();
+    }
+
+    inline std::vector<Engine>& engines() {
+        static std::vector<Engine> registry{
+            { "Prim", runAlgorithm<PrimsAlgorithm<>>, 5000, true, false, createEngine<PrimsAlgorithm<>> },
+            { "Kruskal", runAlgorithm<KruskalAlgorithm<>>, 5000, true, false, createEngine<KruskalAlgorithm<>> },
+            { "Boruvka", runAlgorithm<BoruvkaAlgorithm<>>, 5000, true, false, createEngine<BoruvkaAlgorithm<>> },
+            { "ReverseDelete", runAlgorithm<ReverseDeleteAlgorithm>, 500, true, true, createEngine<ReverseDeleteAlgorithm> },
+            { "Karger", runAlgorithm<KargerAlgorithm>, 5000, true, false, createEngine<KargerAlgorithm> },
+            { "FredmanTarjan", runAlgorithm<FredmanTarjan<>>, 5000, true, false, createEngine<FredmanTarjan<>> },
+            { "Chazelle", runAlgorithm<Chazelle>, 5000, true, false, createEngine<Chazelle> },
+
+            // compact and floating point weights, 64-bit node ids, the compressed graph and plain CSR
+            { "Prim-u16", runTypedAlgorithm<PrimsAlgorithm<std::uint16_t>, std::uint16_t>, 5000, false },
+            { "Prim-float", runTypedAlgorithm<PrimsAlgorithm<float>, float>, 5000, false },
+            { "Kruskal-u16", runTypedAlgorithm<KruskalAlgorithm<std::uint16_t>, std::uint16_t>, 5000, false },
+            { "Kruskal-float", runTypedAlgorithm<KruskalAlgorithm<float>, float>, 5000, false },
+            { "Kruskal-id64", runTypedAlgorithm<KruskalAlgorithm<int, long long>, int, long long>, 5000, false },
+            { "Boruvka-u16", runTypedAlgorithm<BoruvkaAlgorithm<std::uint16_t>, std::uint16_t>, 5000, false },
+            { "Boruvka-float", runTypedAlgorithm<BoruvkaAlgorithm<float>, float>, 5000, false },
+            { "Prim-compressed", runCompressedAlgorithm<PrimsAlgorithm<int, int, mstgen::CompressedCSR>>, 5000, false },
+            { "Boruvka-compressed", runCompressedAlgorithm<BoruvkaAlgorithm<int, int, mstgen::CompressedCSR>>, 5000, false },
+            // on a stored graph (--input) they run on the mapped file, which isn't copied to an adjacency list
+            { "Prim-csr", runCSRAlgorithm<PrimsAlgorithm<int, int, mstgen::CSRView>>, 5000, false, false, {}, runViewAlgorithm<PrimsAlgorithm<int, int, mstgen::CSRView>> },
+            { "Boruvka-csr", runCSRAlgorithm<BoruvkaAlgorithm<int, int, mstgen::CSRView>>, 5000, false, false, {}, runViewAlgorithm<BoruvkaAlgorithm<int, int, mstgen::CSRView>> },
+
+            // variants used for comparison of the heaps and parallel Chazelle
+            { "FredmanTarjan-dary", runAlgorithm<FredmanTarjan<DaryHeap<4>>>, 5000, false, false, createEngine<FredmanTarjan<DaryHeap<4>>> },
+            { "FredmanTarjan-rankPairing", runAlgorithm<FredmanTarjan<RankPairingHeap>>, 5000, false, false, createEngine<FredmanTarjan<RankPairingHeap>> },
+            { "FredmanTarjan-fibonacci", runAlgorithm<FredmanTarjan<FibonacciHeap>>, 5000, false, false, createEngine<FredmanTarjan<FibonacciHeap>> },
+            { "Chazelle-parallel", [](mstgen::AdjList& adjacencyList, MSTResult<>* result, const RunHooks* hooks) {
+                ChazelleOptions options{};
+                options.parallel = true;
+                Chazelle chazelle(options);
+                measured(hooks, [&] {
+                    chazelle.prepare(adjacencyList);
+                    chazelle.solve();
+                });
+                if (result) *result = chazelle.getResult();
+                return EngineRun{ static_cast<double>(chazelle.getMSTWeight()), chazelle.getDuration(), chazelle.getPhaseTimes() };
+            }, 5000, false, false, [] {
+                ChazelleOptions options{};
+                options.parallel = true;
+                return std::unique_ptr<MSTEngine>(std::make_unique<AlgorithmEngine<Chazelle>>(options));
+            } },
+        };
+        return registry;
+    }
+
+    // runs the engine on the graph shared by all engines, the graph stays unchanged
+    // the copy for an engine that changes the graph is made before the hooks start
+    inline EngineRun runOnSharedGraph(const Engine& engine, mstgen::AdjList& graph, MSTResult<>* result = nullptr, const RunHooks* hooks = nullptr) {
+        if (!engine.mutatesInput) return engine.run(graph, result, hooks);
+
+        auto copy = graph;
+        return engine.run(copy, result, hooks);
+    }
+
+    // adds a new engine or replaces the one with the same name
+    inline void registerEngine(Engine engine) {
+        for (auto& registered : engines()) {
+            if (registered.name == engine.name) {
+                registered = std::move(engine);
+                return;
+            }
+        }
+        engines().push_back(std::move(engine));
+    }
+
+    inline std::string engineNames() {
+        std::string names;
+        for (const auto& engine : engines()) {
+            names += (names.empty() ? "" : ", ") + engine.name;
+        }
+        return names;
+    }
+
+    inline const Engine& findEngine(const std::string& name) {
+        for (const auto& engine : engines()) {
+            if (engine.name == name) return engine;
+        }
+        throw std::invalid_argument("unknown algorithm " + name + " (available: " + engineNames() + ")");
+    }
+
+    // empty list means the default engines, "all" means all registered engines
+    inline std::vector<Engine> selectEngines(const std::vector<std::string>& names) {
+        std::vector<Engine> selected;
+
+        if (names.empty() || (names.size() == 1 && names[0] == "all")) {
+            for (const auto& engine : engines()) {
+                if (!names.empty() || engine.byDefault) selected.push_back(engine);
+            }
+            return selected;
+        }
+
+        for (const auto& name : names) {
+            selected.push_back(findEngine(name));
+        }
+        return selected;
+    }
+
+    // engines that stream the edges from a file (GraphIO/EdgeStream.hpp) and keep only O(n) state and the buffers in memory
+    struct StreamEngine {
+        std::string name;
+        // the forest is copied to the result after the timed run if it's not null
+        std::function<EngineRun(const std::string&, const StreamOptions&, MSTResult<>*)> run;
+    };
+
+    inline std::vector<StreamEngine>& streamEngines() {
+        static std::vector<StreamEngine> registry{
+            { "ExternalKruskal", [](const std::string& path, const StreamOptions& stream, MSTResult<>* result) {
+                ExternalKruskalOptions options{};
+                options.memoryBytes = stream.memoryBytes;
+                options.tempDirectory = stream.tempDirectory;
+                ExternalKruskalAlgorithm kruskal(path, options);
+                if (result) *result = kruskal.getResult();
+                return EngineRun{ static_cast<double>(kruskal.getMSTWeight()), kruskal.getDuration(), kruskal.getPhaseTimes(), kruskal.getNodesNumber() };
+            } },
+            { "StreamingMSF", [](const std::string& path, const StreamOptions& stream, MSTResult<>* result) {
+                StreamingMSFOptions options{};
+                options.memoryBytes = stream.memoryBytes;
+                StreamingMSFAlgorithm msf(path, options);
+                if (result) *result = msf.getResult();
+                return EngineRun{ static_cast<double>(msf.getMSTWeight()), msf.getDuration(), msf.getPhaseTimes(), msf.getNodesNumber() };
+            } },
+        };
+        return registry;
+    }
+
+    // empty list or "all" means all streaming engines
+    inline std::vector<StreamEngine> selectStreamEngines(const std::vector<std::string>& names) {
+        if (names.empty() || (names.size() == 1 && names[0] == "all")) return streamEngines();
+
+        std::vector<StreamEngine> selected;
+        for (const auto& name : names) {
+            auto it = std::find_if(streamEngines().begin(), streamEngines().end(), [&](const StreamEngine& engine) { return engine.name == name; });
+            if (it == streamEngines().end()) throw std::invalid_argument("unknown streaming algorithm " + name);
+            selected.push_back(*it);
+        }
+        return selected;
+    }
+
+} // namespace mstbench
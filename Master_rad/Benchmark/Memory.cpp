@@ -0,0 +1,102 @@
+#include "Memory.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <new>
+
+// replacement of the global operator new/delete that counts allocations for the benchmark
+// every block starts with a header (original pointer and size) placed right before the returned address,
+// so delete knows the size even when the unsized version is called
+
+namespace mstbench {
+
+    AllocationCounters& allocationCounters() {
+        static AllocationCounters counters;
+        return counters;
+    }
+
+}
+
+namespace
+{
+    struct BlockHeader
+    {
+        void* raw;
+        std::size_t size;
+    };
+
+    constexpr std::size_t headerSize = 2 * sizeof(void*) > 16 ? 2 * sizeof(void*) : 16;
+
+    void* allocate(std::size_t size, std::size_t alignment) noexcept
+    {
+        alignment = alignment < headerSize ? headerSize : alignment;
+
+        void* raw = std::malloc(size + headerSize + alignment);
+        if (!raw) return nullptr;
+
+        // the first aligned address that leaves space for the header
+        std::uintptr_t address = reinterpret_cast<std::uintptr_t>(raw) + headerSize;
+        address = (address + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+
+        BlockHeader header{ raw, size };
+        std::memcpy(reinterpret_cast<void*>(address - sizeof(BlockHeader)), &header, sizeof(BlockHeader));
+
+        auto& counters = mstbench::allocationCounters();
+        counters.allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+        counters.allocations.fetch_add(1, std::memory_order_relaxed);
+
+        std::size_t live = counters.liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+        std::size_t peak = counters.peakLiveBytes.load(std::memory_order_relaxed);
+        while (live > peak && !counters.peakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+
+        return reinterpret_cast<void*>(address);
+    }
+
+    void* allocateOrThrow(std::size_t size, std::size_t alignment)
+    {
+        while (true) {
+            if (void* pointer = allocate(size, alignment)) return pointer;
+
+            // the standard behaviour: call the new handler until it gives up
+            std::new_handler handler = std::get_new_handler();
+            if (!handler) throw std::bad_alloc();
+            handler();
+        }
+    }
+
+    void release(void* pointer) noexcept
+    {
+        if (!pointer) return;
+
+        BlockHeader header;
+        std::memcpy(&header, static_cast<char*>(pointer) - sizeof(BlockHeader), sizeof(BlockHeader));
+
+        mstbench::allocationCounters().liveBytes.fetch_sub(header.size, std::memory_order_relaxed);
+        std::free(header.raw);
+    }
+}
+
+void* operator new(std::size_t size) { return allocateOrThrow(size, 0); }
+void* operator new[](std::size_t size) { return allocateOrThrow(size, 0); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocate(size, 0); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocate(size, 0); }
+
+void* operator new(std::size_t size, std::align_val_t alignment) { return allocateOrThrow(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return allocateOrThrow(size, static_cast<std::size_t>(alignment)); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocate(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocate(size, static_cast<std::size_t>(alignment)); }
+
+void operator delete(void* pointer) noexcept { release(pointer); }
+void operator delete[](void* pointer) noexcept { release(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { release(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { release(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { release(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { release(pointer); }
+
+void operator delete(void* pointer, std::align_val_t) noexcept { release(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { release(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { release(pointer); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept { release(pointer); }
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { release(pointer); }
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { release(pointer); }
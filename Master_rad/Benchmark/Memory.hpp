@@ -0,0 +1,118 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <fstream>
+#include <string>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <unistd.h>
+#endif
+
+// memory used by an engine run
+// heap allocations are counted by the global operator new/delete from Memory.cpp, RSS is read from the OS
+
+namespace mstbench {
+
+    // counters updated by every allocation of the program
+    struct AllocationCounters {
+        std::atomic<std::size_t> allocatedBytes{ 0 };
+        std::atomic<std::size_t> allocations{ 0 };
+        std::atomic<std::size_t> liveBytes{ 0 };
+        std::atomic<std::size_t> peakLiveBytes{ 0 };
+    };
+
+    // defined in Memory.cpp together with the operators
+    AllocationCounters& allocationCounters();
+
+    struct MemoryStats {
+        // bytes requested by all allocations during the run
+        std::size_t allocatedBytes{ 0 };
+        std::size_t allocations{ 0 };
+        // the biggest number of bytes allocated at the same time above the level at the start of the run
+        std::size_t peakLiveBytes{ 0 };
+        // peak resident set size of the process during the run, 0 if it's unknown
+        std::size_t peakRss{ 0 };
+    };
+
+    // resident set size of the process in bytes, 0 if it's unknown
+    inline std::size_t currentRss() {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters{};
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return counters.WorkingSetSize;
+        return 0;
+#else
+        std::ifstream statm("/proc/self/statm");
+        std::size_t size = 0, resident = 0;
+        if (statm >> size >> resident) return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        return 0;
+#endif
+    }
+
+    // peak resident set size since the start or since the last resetPeakRss(), 0 if it's unknown
+    inline std::size_t peakRss() {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters{};
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return counters.PeakWorkingSetSize;
+        return 0;
+#else
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line)) {
+            // VmHWM:    1234 kB
+            if (line.rfind("VmHWM:", 0) == 0) return std::stoull(line.substr(6)) * 1024;
+        }
+        return 0;
+#endif
+    }
+
+    // Linux allows to reset the peak, on other systems the peak of the whole process is reported
+    inline void resetPeakRss() {
+#if defined(__linux__)
+        std::ofstream clearRefs("/proc/self/clear_refs");
+        if (clearRefs) clearRefs << "5";
+#endif
+    }
+
+    // measures memory between start() and stop(), runs must not overlap
+    class MemoryScope {
+    public:
+        void start() {
+            auto& counters = allocationCounters();
+
+            resetPeakRss();
+            m_allocatedBytes = counters.allocatedBytes.load();
+            m_allocations = counters.allocations.load();
+            m_liveBytes = counters.liveBytes.load();
+            counters.peakLiveBytes.store(m_liveBytes);
+        }
+
+        MemoryStats stop() const {
+            auto& counters = allocationCounters();
+
+            MemoryStats stats{};
+            stats.allocatedBytes = counters.allocatedBytes.load() - m_allocatedBytes;
+            stats.allocations = counters.allocations.load() - m_allocations;
+            stats.peakLiveBytes = counters.peakLiveBytes.load() - std::min(m_liveBytes, counters.peakLiveBytes.load());
+            stats.peakRss = std::max(peakRss(), currentRss());
+            return stats;
+        }
+
+    private:
+        std::size_t m_allocatedBytes{ 0 };
+        std::size_t m_allocations{ 0 };
+        std::size_t m_liveBytes{ 0 };
+    };
+
+} // namespace mstbench
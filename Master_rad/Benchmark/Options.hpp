@@ -0,0 +1,344 @@
+#pragma once
+
+#include "Timing.hpp"
+#include "../Generators/GraphFamilies.hpp"
+#include "../GraphIO/GraphFile.hpp"
+#include "../Utils/Log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// command line options of the benchmark
+// every option can be given as --name value or --name=value, run with --help for the list
+
+namespace mstbench {
+
+    // how the number of edges grows with n
+    struct GraphModel {
+        enum class Kind { Density, AverageDegree, LogDegree };
+        // parallel CSR generator or the original BGL one, they give different graphs for the same seed
+        enum class Generator { Parallel, BGL };
+
+        Kind kind{ Kind::Density };
+        // density, average degree or k in k * ln(n)
+        double value{ 0.1 };
+        Generator generator{ Generator::Parallel };
+        // structure of the graph, the density is translated into the parameter of the family
+        mstgen::GraphFamily family{ mstgen::GraphFamily::Random };
+        mstgen::WeightDistribution weights{ mstgen::WeightDistribution::Uniform };
+
+        double densityFor(std::size_t n) const {
+            if (n <= 1) return 0.0;
+
+            switch (kind) {
+            case Kind::AverageDegree:
+                return std::clamp(value / static_cast<double>(n - 1), 0.0, 1.0);
+            case Kind::LogDegree:
+                return std::clamp(value * std::log(static_cast<double>(n)) / static_cast<double>(n - 1), 0.0, 1.0);
+            default:
+                return value;
+            }
+        }
+    };
+
+    enum class Mode {
+        // runs the chosen engines and writes algo;n;ms
+        Compare,
+        // runs Chazelle with different soft heap error rates
+        ChazelleEpsilon,
+        // compares soft heap with the standard library
+        SoftHeap,
+        // runs the chosen engines on the worst-case graph families, one csv per family
+        Adversarial,
+        // writes the input graph or a generated one to a binary graph file
+        Convert,
+        // runs the streaming engines on the input edge file
+        Stream
+    };
+
+    // memory limits of the streaming engines
+    struct StreamOptions {
+        // memory for the edges, the union-find and the forest of the nodes come on top of it
+        std::size_t memoryBytes{ std::size_t{ 1 } << 30 };
+        // directory of the temporary files, empty means the system temporary directory
+        std::string tempDirectory{};
+    };
+
+    struct Options {
+        Mode mode{ Mode::Compare };
+        // empty means the default engines
+        std::vector<std::string> algorithms{};
+
+        int from{ 100 };
+        int to{ 10000 };
+        int step{ 100 };
+        // explicit list of sizes, used instead of the range
+        std::vector<int> sizes{};
+        // true if the sizes have been given on the command line, each mode has its own default otherwise
+        bool sizesGiven{ false };
+
+        GraphModel model{};
+
+        // number of graphs for each n
+        int iterations{ 100 };
+        // warmup, repetitions on the same graph and settings of the statistics
+        TimingOptions timing{};
+        // seed of the generator of graph seeds
+        std::uint32_t seed{ 123456 };
+        // explicit graph seeds, used instead of the generated ones
+        std::vector<std::uint32_t> seeds{};
+
+        // soft heap error rates for Mode::ChazelleEpsilon
+        std::vector<double> epsilons{ 1.0 / 2, 1.0 / 4, 1.0 / 8, 1.0 / 16, 1.0 / 64 };
+
+        // graph file used instead of the generator, the sizes and seeds are ignored then
+        std::string input{};
+        // format of the input graph, auto detects it by the extension
+        mstio::GraphFormat inputFormat{ mstio::GraphFormat::Auto };
+        // verify the checksums of a binary input graph, which reads the whole file
+        bool verifyInput{ false };
+
+        StreamOptions stream{};
+
+        // empty means the default file of the mode
+        std::string output{};
+        // binary MST results (GraphIO/MSTResultFile.hpp) of each engine on the first graph of each size, empty writes none
+        std::string mstOutput{};
+        // run each engine on all sizes, ignoring its maxN
+        bool noLimits{ false };
+        // collect hardware performance counters for each run
+        bool perf{ false };
+        // messages up to this level are written (Utils/Log.h), debug adds the engines' weights and the graph diagnostics
+        LogLevel logLevel{ LogLevel::Info };
+        bool help{ false };
+
+        std::vector<int> inputSizes(const std::vector<int>& defaultSizes = {}) const {
+            if (!sizes.empty()) return sizes;
+            if (!sizesGiven && !defaultSizes.empty()) return defaultSizes;
+
+            std::vector<int> range;
+            for (int n = from; n <= to; n += step) {
+                range.push_back(n);
+            }
+            return range;
+        }
+
+        std::string outputPath() const {
+            if (!output.empty()) return output;
+
+            switch (mode) {
+            case Mode::ChazelleEpsilon: return "chazelleEpsilon.csv";
+            case Mode::SoftHeap: return "benchSoftHeap.csv";
+            case Mode::Adversarial: return "adversarial.csv";
+            case Mode::Convert: return "graph.mstg";
+            case Mode::Stream: return "benchStream.csv";
+            default: return "benchDense.csv";
+            }
+        }
+    };
+
+    inline std::string usage() {
+        return
+            "usage: Master_rad [options]\n"
+            "  --mode compare|chazelle-epsilon|softheap|adversarial|convert|stream   what to do (compare)\n"
+            "  --algorithms A,B,...   engines to run, 'all' for every registered engine (default set)\n"
+            "  --from N --to N --step N   range of graph sizes (100, 10000, 100)\n"
+            "  --sizes N,N,...        explicit graph sizes instead of the range\n"
+            "  --density D            edges = D * n(n-1)/2 (0.1)\n"
+            "  --avg-degree K         average degree K\n"
+            "  --log-degree K         average degree K * ln(n)\n"
+            "  --generator parallel|bgl   graph generator (parallel)\n"
+            "  --family random|grid2d|grid3d|geometric|rmat|ba   graph family (random)\n"
+            "           prim-worst|boruvka-worst|karger-worst|chazelle-worst|deep-tree   worst cases of the engines\n"
+            "  --weights uniform|heavy-tailed|ties   weight distribution, geometric graphs use distances (uniform)\n"
+            "  --iterations N         graphs per size (100)\n"
+            "  --warmup N             unmeasured runs on each graph (1)\n"
+            "  --repetitions N        measured runs on each graph, the run* columns are their spread within each graph (3)\n"
+            "  --resamples N          bootstrap resamples for the confidence interval (1000)\n"
+            "  --confidence C         confidence level of the interval (0.95)\n"
+            "  --seed S               seed used to generate graph seeds (123456)\n"
+            "  --seeds S,S,...        explicit graph seeds, sets the number of iterations\n"
+            "  --epsilons E,E,...     soft heap error rates for chazelle-epsilon\n"
+            "  --input PATH           graph file used instead of generated graphs, edge stream (.mste) or edge list for stream\n"
+            "  --format auto|binary|dimacs|metis|mtx|edges   format of the input, auto uses the extension:\n"
+            "           .mstg binary, .gr DIMACS, .graph/.metis METIS, .mtx Matrix Market, else edge list (auto)\n"
+            "  --verify               verify the checksums of the input graph\n"
+            "  --memory MB            memory for the edges of the streaming engines (1024)\n"
+            "  --temp-dir PATH        directory of the temporary files of the streaming engines (system default)\n"
+            "  --output PATH          csv file, or the binary graph for convert, .mste writes an edge stream (depends on the mode)\n"
+            "  --mst-output PATH      write the MST of each engine on the first graph of each size, e.g. mst-Prim-1000.msts\n"
+            "  --no-limits            run every engine on all sizes\n"
+            "  --perf                 collect hardware counters (Linux perf_event_open, empty columns if unavailable)\n"
+            "  --log-level none|error|warning|info|debug   messages to write, debug checks the connectivity of each graph (info)\n"
+            "  --help                 this message\n";
+    }
+
+    namespace detail {
+
+        inline std::vector<std::string> split(const std::string& text) {
+            std::vector<std::string> parts;
+            std::size_t start = 0;
+
+            while (start <= text.size()) {
+                std::size_t end = text.find(',', start);
+                if (end == std::string::npos) end = text.size();
+                if (end > start) parts.push_back(text.substr(start, end - start));
+                start = end + 1;
+            }
+            return parts;
+        }
+
+        template<typename T>
+        T parseNumber(const std::string& name, const std::string& text) {
+            try {
+                std::size_t used = 0;
+                T value{};
+                if constexpr (std::is_floating_point_v<T>) value = static_cast<T>(std::stod(text, &used));
+                else if constexpr (std::is_unsigned_v<T>) value = static_cast<T>(std::stoull(text, &used));
+                else value = static_cast<T>(std::stoll(text, &used));
+
+                if (used == text.size()) return value;
+            }
+            catch (const std::logic_error&) {}
+
+            throw std::invalid_argument("invalid value '" + text + "' for --" + name);
+        }
+
+        template<typename T>
+        std::vector<T> parseList(const std::string& name, const std::string& text) {
+            std::vector<T> values;
+            for (const auto& part : split(text)) {
+                values.push_back(parseNumber<T>(name, part));
+            }
+            if (values.empty()) throw std::invalid_argument("empty list for --" + name);
+            return values;
+        }
+
+    } // namespace detail
+
+    // throws std::invalid_argument for unknown options and invalid values
+    inline Options parseOptions(int argc, char** argv) {
+        Options options{};
+
+        for (int i = 1; i < argc; ++i) {
+            std::string argument = argv[i];
+            if (argument.rfind("--", 0) != 0) throw std::invalid_argument("unexpected argument " + argument);
+
+            std::string name = argument.substr(2);
+            std::string value;
+            bool hasValue = false;
+
+            if (auto equals = name.find('='); equals != std::string::npos) {
+                value = name.substr(equals + 1);
+                name = name.substr(0, equals);
+                hasValue = true;
+            }
+
+            if (name == "help") { options.help = true; continue; }
+            if (name == "no-limits") { options.noLimits = true; continue; }
+            if (name == "perf") { options.perf = true; continue; }
+            if (name == "verify") { options.verifyInput = true; continue; }
+
+            if (!hasValue) {
+                if (i + 1 >= argc) throw std::invalid_argument("missing value for --" + name);
+                value = argv[++i];
+            }
+
+            if (name == "mode") {
+                if (value == "compare") options.mode = Mode::Compare;
+                else if (value == "chazelle-epsilon") options.mode = Mode::ChazelleEpsilon;
+                else if (value == "softheap") options.mode = Mode::SoftHeap;
+                else if (value == "adversarial") options.mode = Mode::Adversarial;
+                else if (value == "convert") options.mode = Mode::Convert;
+                else if (value == "stream") options.mode = Mode::Stream;
+                else throw std::invalid_argument("unknown mode " + value);
+            }
+            else if (name == "algorithms") options.algorithms = detail::split(value);
+            else if (name == "from") { options.from = detail::parseNumber<int>(name, value); options.sizesGiven = true; }
+            else if (name == "to") { options.to = detail::parseNumber<int>(name, value); options.sizesGiven = true; }
+            else if (name == "step") { options.step = detail::parseNumber<int>(name, value); options.sizesGiven = true; }
+            else if (name == "sizes") { options.sizes = detail::parseList<int>(name, value); options.sizesGiven = true; }
+            else if (name == "density") { options.model.kind = GraphModel::Kind::Density; options.model.value = detail::parseNumber<double>(name, value); }
+            else if (name == "avg-degree") { options.model.kind = GraphModel::Kind::AverageDegree; options.model.value = detail::parseNumber<double>(name, value); }
+            else if (name == "log-degree") { options.model.kind = GraphModel::Kind::LogDegree; options.model.value = detail::parseNumber<double>(name, value); }
+            else if (name == "generator") {
+                if (value == "parallel") options.model.generator = GraphModel::Generator::Parallel;
+                else if (value == "bgl") options.model.generator = GraphModel::Generator::BGL;
+                else throw std::invalid_argument("unknown generator " + value);
+            }
+            else if (name == "family") {
+                bool found = false;
+                for (auto family : mstgen::graph_families()) {
+                    if (value == mstgen::graph_family_name(family)) { options.model.family = family; found = true; }
+                }
+                if (!found) throw std::invalid_argument("unknown graph family " + value);
+            }
+            else if (name == "weights") {
+                bool found = false;
+                for (auto weights : { mstgen::WeightDistribution::Uniform, mstgen::WeightDistribution::HeavyTailed, mstgen::WeightDistribution::Ties }) {
+                    if (value == mstgen::weight_distribution_name(weights)) { options.model.weights = weights; found = true; }
+                }
+                if (!found) throw std::invalid_argument("unknown weight distribution " + value);
+            }
+            else if (name == "iterations") options.iterations = detail::parseNumber<int>(name, value);
+            else if (name == "warmup") options.timing.warmup = detail::parseNumber<int>(name, value);
+            else if (name == "repetitions") options.timing.repetitions = detail::parseNumber<int>(name, value);
+            else if (name == "resamples") options.timing.resamples = detail::parseNumber<std::size_t>(name, value);
+            else if (name == "confidence") options.timing.confidence = detail::parseNumber<double>(name, value);
+            else if (name == "seed") options.seed = detail::parseNumber<std::uint32_t>(name, value);
+            else if (name == "seeds") options.seeds = detail::parseList<std::uint32_t>(name, value);
+            else if (name == "epsilons") options.epsilons = detail::parseList<double>(name, value);
+            else if (name == "input") options.input = value;
+            else if (name == "format") {
+                bool found = false;
+                for (auto format : mstio::graph_formats()) {
+                    if (value == mstio::graph_format_name(format)) { options.inputFormat = format; found = true; }
+                }
+                if (!found) throw std::invalid_argument("unknown graph format " + value);
+            }
+            else if (name == "memory") options.stream.memoryBytes = detail::parseNumber<std::size_t>(name, value) << 20;
+            else if (name == "temp-dir") options.stream.tempDirectory = value;
+            else if (name == "output") options.output = value;
+            else if (name == "mst-output") options.mstOutput = value;
+            else if (name == "log-level") {
+                bool found = false;
+                for (auto level : logLevels()) {
+                    if (value == logLevelName(level)) { options.logLevel = level; found = true; }
+                }
+                if (!found) throw std::invalid_argument("unknown log level " + value);
+            }
+            else throw std::invalid_argument("unknown option --" + name);
+        }
+
+        if (options.step <= 0) throw std::invalid_argument("--step must be positive");
+        if (options.stream.memoryBytes == 0) throw std::invalid_argument("--memory must be positive");
+        if (options.mode == Mode::Stream && options.input.empty()) throw std::invalid_argument("--mode stream needs --input");
+        if (options.iterations <= 0) throw std::invalid_argument("--iterations must be positive");
+        if (options.timing.warmup < 0) throw std::invalid_argument("--warmup can't be negative");
+        if (options.timing.repetitions <= 0) throw std::invalid_argument("--repetitions must be positive");
+        if (!(0.0 < options.timing.confidence && options.timing.confidence < 1.0)) throw std::invalid_argument("--confidence must be in (0, 1)");
+        for (double epsilon : options.epsilons) {
+            if (!(0.0 < epsilon && epsilon < 1.0)) throw std::invalid_argument("--epsilons must be in (0, 1)");
+        }
+        if (options.model.kind == GraphModel::Kind::Density && !(0.0 <= options.model.value && options.model.value <= 1.0)) {
+            throw std::invalid_argument("--density must be in [0, 1]");
+        }
+        if (options.model.generator == GraphModel::Generator::BGL
+            && (options.model.family != mstgen::GraphFamily::Random || options.model.weights != mstgen::WeightDistribution::Uniform)) {
+            throw std::invalid_argument("--generator bgl supports only random graphs with uniform weights");
+        }
+        for (int n : options.inputSizes()) {
+            if (n <= 0) throw std::invalid_argument("graph sizes must be positive");
+        }
+        if (!options.seeds.empty()) options.iterations = static_cast<int>(options.seeds.size());
+
+        return options;
+    }
+
+} // namespace mstbench
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// hardware performance counters of the calling thread and the threads it starts, e.g. parallel Chazelle (perf_event_open on Linux)
+// when the counters can't be opened (other OS, no PMU in a VM, perf_event_paranoid) the collector does nothing
+// and available() is false, so the benchmark works everywhere
+
+namespace mstbench {
+
+    enum class PerfEvent { Cycles, Instructions, L1DMisses, LLCMisses, BranchMisses, DTLBMisses, Count };
+
+    constexpr std::size_t perfEventsNumber = static_cast<std::size_t>(PerfEvent::Count);
+
+    inline const char* perfEventName(std::size_t event) {
+        static const char* names[perfEventsNumber] = { "cycles", "instructions", "l1dMisses", "llcMisses", "branchMisses", "dtlbMisses" };
+        return names[event];
+    }
+
+    struct PerfValues {
+        std::array<double, perfEventsNumber> values{};
+        // the event has been counted, values of the other events are meaningless
+        std::array<bool, perfEventsNumber> valid{};
+    };
+
+    class PerfCounters {
+    public:
+        PerfCounters() {
+#if defined(__linux__)
+            auto cache = [](std::uint64_t cache, std::uint64_t result) {
+                return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (result << 16);
+            };
+
+            const std::array<std::pair<std::uint32_t, std::uint64_t>, perfEventsNumber> events{ {
+                { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+                { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+                { PERF_TYPE_HW_CACHE, cache(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_RESULT_MISS) },
+                { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+                { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+                { PERF_TYPE_HW_CACHE, cache(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_RESULT_MISS) },
+            } };
+
+            for (std::size_t i = 0; i < perfEventsNumber; ++i) {
+                perf_event_attr attr{};
+                attr.size = sizeof(attr);
+                attr.type = events[i].first;
+                attr.config = events[i].second;
+                attr.disabled = 1;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                attr.inherit = 1;
+                // counters are multiplexed when there are not enough of them, the values are scaled in stop()
+                attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+                m_fds[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+            }
+#endif
+        }
+
+        ~PerfCounters() {
+#if defined(__linux__)
+            for (int fd : m_fds) {
+                if (fd != -1) close(fd);
+            }
+#endif
+        }
+
+        PerfCounters(const PerfCounters&) = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+
+        bool available() const {
+            for (int fd : m_fds) {
+                if (fd != -1) return true;
+            }
+            return false;
+        }
+
+        void start() {
+#if defined(__linux__)
+            for (int fd : m_fds) {
+                if (fd == -1) continue;
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+#endif
+        }
+
+        PerfValues stop() {
+            PerfValues result{};
+#if defined(__linux__)
+            for (int fd : m_fds) {
+                if (fd != -1) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            }
+
+            for (std::size_t i = 0; i < perfEventsNumber; ++i) {
+                if (m_fds[i] == -1) continue;
+
+                // value, time enabled, time running
+                std::uint64_t data[3]{};
+                if (read(m_fds[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)) || !data[2]) continue;
+
+                result.values[i] = static_cast<double>(data[0]) * static_cast<double>(data[1]) / static_cast<double>(data[2]);
+                result.valid[i] = true;
+            }
+#endif
+            return result;
+        }
+
+    private:
+        std::array<int, perfEventsNumber> m_fds{ -1, -1, -1, -1, -1, -1 };
+    };
+
+} // namespace mstbench
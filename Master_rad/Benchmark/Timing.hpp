@@ -0,0 +1,186 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+// statistics of the measured times of one engine on graphs of the same size
+// samples come from repeated runs on the same graphs, the warmup runs are not included
+// runs on several graphs (seeds) are summarized with summarizeGraphs, so the differences between the graphs are not counted as noise
+
+namespace mstbench {
+
+    struct TimingSummary {
+        std::size_t samples{ 0 };
+        double mean{ 0 };
+        double median{ 0 };
+        double p10{ 0 };
+        double p90{ 0 };
+        double stddev{ 0 };
+        // bootstrap confidence interval of the median
+        double ciLow{ 0 };
+        double ciHigh{ 0 };
+        // samples outside of Tukey's fences (1.5 IQR from the quartiles)
+        std::size_t outliers{ 0 };
+        // too many outliers or too wide confidence interval, the result shouldn't be trusted
+        bool noisy{ false };
+    };
+
+    struct TimingOptions {
+        // runs on each graph that are not measured (caches, allocator, branch predictors)
+        int warmup{ 1 };
+        // measured runs on each graph
+        int repetitions{ 3 };
+        // number of bootstrap resamples
+        std::size_t resamples{ 1000 };
+        double confidence{ 0.95 };
+        // result is noisy if the confidence interval is wider than this part of the median
+        double maxRelativeInterval{ 0.1 };
+        // result is noisy if there are more outliers than this part of the samples
+        double maxOutliers{ 0.05 };
+    };
+
+    // linear interpolation between the closest ranks, values have to be sorted
+    inline double percentile(const std::vector<double>& sorted, double q) {
+        if (sorted.empty()) throw std::invalid_argument("percentile of an empty sample");
+
+        double position = q * static_cast<double>(sorted.size() - 1);
+        std::size_t below = static_cast<std::size_t>(std::floor(position));
+        std::size_t above = std::min(below + 1, sorted.size() - 1);
+        double fraction = position - static_cast<double>(below);
+
+        return sorted[below] + fraction * (sorted[above] - sorted[below]);
+    }
+
+    inline TimingSummary summarize(std::vector<double> samples, const TimingOptions& options = {}, std::uint32_t seed = 123) {
+        TimingSummary summary{};
+        summary.samples = samples.size();
+        if (samples.empty()) return summary;
+
+        std::sort(samples.begin(), samples.end());
+
+        const double n = static_cast<double>(samples.size());
+        summary.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / n;
+        summary.median = percentile(samples, 0.5);
+        summary.p10 = percentile(samples, 0.1);
+        summary.p90 = percentile(samples, 0.9);
+
+        double squares = 0;
+        for (double sample : samples) {
+            squares += (sample - summary.mean) * (sample - summary.mean);
+        }
+        summary.stddev = samples.size() > 1 ? std::sqrt(squares / (n - 1)) : 0.0;
+
+        const double q1 = percentile(samples, 0.25);
+        const double q3 = percentile(samples, 0.75);
+        const double iqr = q3 - q1;
+        summary.outliers = std::count_if(samples.begin(), samples.end(), [&](double sample) {
+            return sample < q1 - 1.5 * iqr || sample > q3 + 1.5 * iqr;
+        });
+
+        // bootstrap: medians of the samples drawn with replacement
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<std::size_t> pick(0, samples.size() - 1);
+        std::vector<double> resample(samples.size());
+        std::vector<double> medians(options.resamples);
+
+        for (auto& median : medians) {
+            for (auto& value : resample) value = samples[pick(gen)];
+            std::sort(resample.begin(), resample.end());
+            median = percentile(resample, 0.5);
+        }
+        std::sort(medians.begin(), medians.end());
+
+        if (!medians.empty()) {
+            const double alpha = (1.0 - options.confidence) / 2;
+            summary.ciLow = percentile(medians, alpha);
+            summary.ciHigh = percentile(medians, 1.0 - alpha);
+        }
+
+        const bool wideInterval = summary.median > 0 && (summary.ciHigh - summary.ciLow) > options.maxRelativeInterval * summary.median;
+        const bool manyOutliers = static_cast<double>(summary.outliers) > options.maxOutliers * n;
+        summary.noisy = wideInterval || manyOutliers;
+
+        return summary;
+    }
+
+    // samples[g] are the repetitions on the graph g, all in the measured milliseconds
+    // mean, median, p10 and p90 are of all samples, the spread describes the repetitions and not the differences between the graphs:
+    // stddev is pooled from the deviations from the mean of each graph and the outliers are those deviations outside of Tukey's fences,
+    // the confidence interval of the median comes from a bootstrap that resamples the repetitions within each graph
+    inline TimingSummary summarizeGraphs(const std::vector<std::vector<double>>& samples, const TimingOptions& options = {}, std::uint32_t seed = 123) {
+        std::vector<double> all, deviations;
+        std::size_t graphs = 0;
+        for (const auto& times : samples) {
+            if (times.empty()) continue;
+            ++graphs;
+            const double mean = std::accumulate(times.begin(), times.end(), 0.0) / static_cast<double>(times.size());
+            for (double time : times) {
+                all.push_back(time);
+                deviations.push_back(time - mean);
+            }
+        }
+
+        TimingSummary summary{};
+        summary.samples = all.size();
+        if (all.empty()) return summary;
+
+        std::vector<double> sorted = all;
+        std::sort(sorted.begin(), sorted.end());
+        const double n = static_cast<double>(all.size());
+        summary.mean = std::accumulate(all.begin(), all.end(), 0.0) / n;
+        summary.median = percentile(sorted, 0.5);
+        summary.p10 = percentile(sorted, 0.1);
+        summary.p90 = percentile(sorted, 0.9);
+
+        // each graph loses one degree of freedom to its own mean
+        double squares = 0;
+        for (double deviation : deviations) {
+            squares += deviation * deviation;
+        }
+        summary.stddev = all.size() > graphs ? std::sqrt(squares / static_cast<double>(all.size() - graphs)) : 0.0;
+
+        std::sort(deviations.begin(), deviations.end());
+        const double q1 = percentile(deviations, 0.25);
+        const double q3 = percentile(deviations, 0.75);
+        const double iqr = q3 - q1;
+        summary.outliers = std::count_if(deviations.begin(), deviations.end(), [&](double deviation) {
+            return deviation < q1 - 1.5 * iqr || deviation > q3 + 1.5 * iqr;
+        });
+
+        // bootstrap: every graph keeps its number of samples, drawn with replacement from its own repetitions
+        std::mt19937 gen(seed);
+        std::vector<double> resample(all.size());
+        std::vector<double> medians(options.resamples);
+
+        for (auto& median : medians) {
+            std::size_t next = 0;
+            for (const auto& times : samples) {
+                if (times.empty()) continue;
+                std::uniform_int_distribution<std::size_t> pick(0, times.size() - 1);
+                for (std::size_t i = 0; i < times.size(); ++i) resample[next++] = times[pick(gen)];
+            }
+            std::sort(resample.begin(), resample.end());
+            median = percentile(resample, 0.5);
+        }
+        std::sort(medians.begin(), medians.end());
+
+        if (!medians.empty()) {
+            const double alpha = (1.0 - options.confidence) / 2;
+            summary.ciLow = percentile(medians, alpha);
+            summary.ciHigh = percentile(medians, 1.0 - alpha);
+        }
+
+        const bool wideInterval = summary.median > 0 && (summary.ciHigh - summary.ciLow) > options.maxRelativeInterval * summary.median;
+        const bool manyOutliers = static_cast<double>(summary.outliers) > options.maxOutliers * n;
+        summary.noisy = wideInterval || manyOutliers;
+
+        return summary;
+    }
+
+} // namespace mstbench
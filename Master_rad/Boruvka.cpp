@@ -1,4 +1,9 @@
 #include "Utils/UnionFind.h"
+#include "Utils/PhaseTimer.h"
+#include "Utils/Log.h"
+#include "Utils/WeightTraits.h"
+#include "Utils/MSTResult.h"
+#include "Utils/GraphAccess.h"
 
 #include <vector>
 #include <queue>
@@ -12,71 +17,116 @@ using namespace std;
 using Clock = std::chrono::steady_clock;
 using ms = std::chrono::duration<double, std::milli>;
 
-typedef pair<int, int> branch;
-
+// Weight and Index are the types of the weights and the node ids, the common ones are instantiated in Benchmark/EngineInstantiations.cpp
+// Graph is read through GraphAccess, e.g. the adjacency list or mstgen::CompressedCSR
+template<typename Weight = int, typename Index = int, typename Graph = WeightedAdjacencyList<Weight, Index>>
 class BoruvkaAlgorithm {
+	typedef pair<Index, Index> branch;
+	using Sum = typename WeightTraits<Weight>::Sum;
+	using Access = GraphAccess<Graph>;
+
+	// the cheapest edge leaving a component, x is -1 if there is none
+	// it takes 12 bytes with 16-bit weights and 32-bit ids instead of a vector of three ints
+	struct CheapestBranch {
+		Index x{ -1 };
+		Index y{ -1 };
+		Weight weight{};
+	};
+
 public:
-	BoruvkaAlgorithm(vector<vector<pair<int, int>>>& adjacencyList)
-		: m_adjacencyList(adjacencyList)
-		, m_nodesNumber(adjacencyList.size())
-		, m_unionFind(adjacencyList.size())
+	// an engine kept for many graphs (Utils/MSTEngine.h) calls prepare and solve for each of them
+	BoruvkaAlgorithm() = default;
+
+	BoruvkaAlgorithm(Graph& adjacencyList)
 	{ 
-		auto start = Clock::now();
-		findMST();
-		auto end = Clock::now();
+		prepare(adjacencyList);
+		solve();
 
-		m_duration = std::chrono::duration_cast<ms>(end - start).count();
-		
+		MST_LOG(Debug, "Boruvka: " << m_mstWeight);
+	}
+
+	// binds the graph and resets the union-find and the cheapest branches, their memory is reused
+	void prepare(Graph& adjacencyList) {
+		m_adjacencyList = &adjacencyList;
+		m_nodesNumber = static_cast<Index>(Access::nodesNumber(adjacencyList));
+		m_unionFind.reset(m_nodesNumber);
+		m_cheapestBranch.assign(m_nodesNumber, CheapestBranch{});
+		m_MST.clear();
+		m_mstWeight = 0;
+		m_phases = {};
+	}
+
+	void solve() {
+		// Boruvka works directly on the graph, there is no conversion
+		PhaseTimer timer;
+		findMST();
+		timer.finish(m_phases.core);
 		printMST();
-		cout << "Boruvka: " << m_mstWeight << endl;
+		timer.finish(m_phases.materialization);
+
+		m_duration = m_phases.total();
 	}
 
-	size_t getMSTWeight() { return m_mstWeight; }
+	Sum getMSTWeight() { return m_mstWeight; }
 
 	double getDuration() { return m_duration; }
 
+	PhaseTimes getPhaseTimes() { return m_phases; }
+
+	// visit(u, v, weight) for each MST edge in the order they were added
+	template<typename Visit>
+	void forEachMSTEdge(Visit visit) {
+		for (const auto& edge : m_MST) {
+			visit(edge.second.first, edge.second.second, edge.first);
+		}
+	}
+
+	// the graph has to be unchanged, the ids are looked up in it
+	MSTResult<Weight, Index> getResult() {
+		vector<MSTEdge<Weight, Index>> edges;
+		forEachMSTEdge([&](Index u, Index v, Weight weight) { edges.push_back({ u, v, weight, noEdgeId }); });
+		assignEdgeIds(*m_adjacencyList, edges);
+		return buildMSTResult(static_cast<size_t>(m_nodesNumber), move(edges));
+	}
+
 private:
 	void findMST() {
 		
-		int numOfComponents = m_nodesNumber;
+		Index numOfComponents = m_nodesNumber;
+		auto& cheapestBranch = m_cheapestBranch;
 
-		// the cheapest branch to each component
-		vector<vector<int>> cheapestBranch(m_nodesNumber, vector<int>(3, -1));
-
-		// until there is only one component - MST
+		// until there is only one component - MST, or no edge connects two components - MSF of a disconnected graph
 		while (numOfComponents > 1) {
+			Index previousComponents = numOfComponents;
 
-			for(int i = 0; i < m_adjacencyList.size(); i++){
-				for (int j = 0; j < m_adjacencyList[i].size(); j++) {
-					int x = i;
-					int y = m_adjacencyList[i][j].first;
-
-					int fx = m_unionFind.find(x);
-					int fy = m_unionFind.find(y);
+			for(Index i = 0; i < m_nodesNumber; i++){
+				Access::forEachNeighbor(*m_adjacencyList, i, [&](Index y, Weight weight) {
+					Index x = i;
 
-					int weight = m_adjacencyList[i][j].second;
+					Index fx = m_unionFind.find(x);
+					Index fy = m_unionFind.find(y);
 
 					// if current edge (x, y) does not belong to one connected component, use it as the next cheapest edge that expands the component
 					if (fx != fy) {
-						if (cheapestBranch[fx][2] == -1 || cheapestBranch[fx][2] > weight) {
+						if (cheapestBranch[fx].x == -1 || cheapestBranch[fx].weight > weight) {
 							cheapestBranch[fx] = {x, y, weight};
 						}
-						if (cheapestBranch[fy][2] == -1 || cheapestBranch[fy][2] > weight) {
+						if (cheapestBranch[fy].x == -1 || cheapestBranch[fy].weight > weight) {
 							cheapestBranch[fy] = {x, y, weight};
 						}
 					}
-				}
+				});
 			}
 
 			// connect components
-			for (int i = 0; i < m_nodesNumber; i++) {
-				if(cheapestBranch[i][2] != -1) {
-					int x = cheapestBranch[i][0];
-					int y = cheapestBranch[i][1];
-					int weight = cheapestBranch[i][2];
+			for (Index i = 0; i < m_nodesNumber; i++) {
+				if(cheapestBranch[i].x != -1) {
+					Index x = cheapestBranch[i].x;
+					Index y = cheapestBranch[i].y;
+					Weight weight = cheapestBranch[i].weight;
 
-					int fx = m_unionFind.find(x);
-					int fy = m_unionFind.find(y);
+					Index fx = m_unionFind.find(x);
+					Index fy = m_unionFind.find(y);
 
 					if (fx != fy) {
 						m_unionFind.unionOperation(fx, fy);
@@ -87,9 +137,11 @@ private:
 				}
 			}
 
+			if (numOfComponents == previousComponents) break;
+
 			// prepare for the next iteration
-			for (int i = 0; i < m_nodesNumber; i++) {
-				cheapestBranch[i][2] = -1;
+			for (Index i = 0; i < m_nodesNumber; i++) {
+				cheapestBranch[i].x = -1;
 			}
 		}
 	}
@@ -103,13 +155,17 @@ private:
 	}
 
 private:
-	int m_nodesNumber{ 0 };
+	Index m_nodesNumber{ 0 };
 
-	size_t m_mstWeight{ 0 };
+	Sum m_mstWeight{ 0 };
 	double m_duration{ 0 };
+	PhaseTimes m_phases{};
+
+	vector<pair<Weight, branch>> m_MST;
+	Graph* m_adjacencyList{ nullptr };
 
-	vector<pair<int, branch>> m_MST;
-	vector<vector<pair<int, int>>>& m_adjacencyList;
+	// the cheapest branch to each component
+	vector<CheapestBranch> m_cheapestBranch;
 
-	UnionFind m_unionFind;
+	BasicUnionFind<Index> m_unionFind;
 };
\ No newline at end of file
@@ -1,6 +1,12 @@
 #include "Graph.h"
 #include "MSTUtils.h"
+#include "Statistics.h"
 #include "TreeBuilder.h"
+#include "SoftHeap/Utils.h"
+#include "../Utils/PhaseTimer.h"
+#include "../Utils/Log.h"
+#include "../Utils/MSTResult.h"
+#include "../Utils/TaskPool.h"
 
 #include <vector>
 #include <queue>
@@ -33,12 +39,50 @@ namespace
     }
 }
 
+struct ChazelleOptions
+{
+    // independent subgraphs of each recursion level are solved on all cores
+    bool parallel = false;
+    // soft heap error rate, the textbook value is 1/c
+    double epsilon = 1.0 / MST::c;
+    // soft heap parameter r, if it's 0 it is calculated from epsilon
+    size_t r = 0;
+};
+
 class Chazelle {
 public:
-	Chazelle(vector<vector<pair<int, int>>>& adjacencyList)
-		: m_nodesNumber(adjacencyList.size())
+    // an engine kept for many graphs (Utils/MSTEngine.h) calls prepare and solve for each of them
+    explicit Chazelle(ChazelleOptions options = {})
+        : m_options(options)
+        , m_r(options.r ? options.r : CalculateRByEps(options.epsilon))
+    {
+    }
+
+	Chazelle(vector<vector<pair<int, int>>>& adjacencyList, ChazelleOptions options = {})
+		: Chazelle(options)
 	{
-        vector<tuple<int, int, int>> edges = {};
+        prepare(adjacencyList);
+        solve();
+
+        MST_LOG(Debug, "Chazelle: " << m_mstWeight);
+    }
+
+    // binds the graph, the edge list keeps its memory, the recursion builds its own graphs
+    void prepare(vector<vector<pair<int, int>>>& adjacencyList) {
+        m_adjacencyList = &adjacencyList;
+        m_nodesNumber = adjacencyList.size();
+        m_edges.clear();
+        m_result.clear();
+        m_statistics = {};
+        m_mstWeight = 0;
+        m_phases = {};
+    }
+
+    void solve() {
+        PhaseTimer timer;
+
+        const auto& adjacencyList = *m_adjacencyList;
+        vector<tuple<int, int, int>>& edges = m_edges;
 
         for (int i = 0; i < m_nodesNumber; ++i) {
             for (int j = 0; j < adjacencyList[i].size(); ++j) {
@@ -51,29 +95,32 @@ public:
             }
         }
 
-        auto start = Clock::now();
         // create graph
         Graph graph = Graph(edges);
+        timer.finish(m_phases.conversion);
 
-        // MST construction
-        int height = MST::findMaxHeight(graph, MST::c);
-
-        list<int> result = findMST(graph, height);
-        auto end = Clock::now();
+        int height = edges.empty() ? 0 : MST::findMaxHeight(graph, MST::c);
+        timer.finish(m_phases.preprocessing);
 
-        m_duration = std::chrono::duration_cast<ms>(end - start).count();
+        // MST construction, a graph without edges (only isolated nodes) is a forest already
+        if (!edges.empty()) m_result = findMST(graph, height, m_statistics, 0, m_options.parallel);
+        timer.finish(m_phases.core);
 
         // print result:
-        for (int edgeIndex : result) {
+        for (int edgeIndex : m_result) {
             //cout << "( " << get<0>(edges[edgeIndex]) << ", " << get<1>(edges[edgeIndex]) << ") weight: " << get<2>(edges[edgeIndex]) << endl;
             m_mstWeight += get<2>(edges[edgeIndex]);
         }
+        timer.finish(m_phases.materialization);
 
-        cout << "Chazelle: " << m_mstWeight << endl;
+        m_duration = m_phases.total();
 	}
 
-    list<int> findMST(Graph& graph, int treeHeight, int t = 0)
+    // depth - depth of the current recursive call, used only for statistics
+    vector<int> findMST(Graph& graph, int treeHeight, ChazelleStatistics& statistics, int t = 0, bool parallel = false, size_t depth = 0)
     {
+        statistics.recursionDepth = max(statistics.recursionDepth, depth);
+
         if (!t) {
             t = calculateParameterT(graph, treeHeight <= 2 ? 3 : treeHeight);
         }
@@ -81,20 +128,20 @@ public:
         int count = t <= 1 ? numeric_limits<int>::max() : MST::c;
 
         bool noChanges = false;
-        list<int> boruvkaResult = graph.boruvkaPhase(count, &noChanges);
+        vector<int> boruvkaResult = graph.boruvkaPhase(count, &noChanges);
         // if Boruvka phase hasn't produced any changes the algorithm stops here and solution has been found
         if (noChanges) {
             return boruvkaResult;
         }
 
         set<int> nodes = graph.getNodes();
-        list<int> badEdges = {};
-        list<Graph> graphs{};
+        vector<int> badEdges = {};
+        vector<Graph> graphs{};
 
         // while there is any unprocessed component
         while (!nodes.empty())
         {
-            auto  treeBuilder = TreeBuilder(graph, t, treeHeight, *nodes.begin());
+            auto  treeBuilder = TreeBuilder(graph, t, treeHeight, *nodes.begin(), m_r);
             auto& tree = treeBuilder.getTree();
 
             for (const auto& node : tree.getVerticesInside()) {
@@ -103,17 +150,39 @@ public:
 
             auto currentBadEdges = tree.getBadEdges();
 
-            graphs.splice(graphs.end(), tree.createSubGraphs(currentBadEdges));
-            std::ranges::move(currentBadEdges, std::inserter(badEdges, badEdges.end()));
+            statistics.treesNumber++;
+            statistics.corruptionsNumber += tree.getCorruptionsNumber();
+            statistics.corruptedEdgesNumber += currentBadEdges.size();
+            statistics.addBadEdges(depth, currentBadEdges.size());
+
+            MoveAppend(graphs, tree.createSubGraphs(currentBadEdges));
+            badEdges.insert(badEdges.end(), currentBadEdges.begin(), currentBadEdges.end());
         }
 
-        list<int> badEdgesCopy = badEdges;
-        for (auto& subgraph : graphs) {
-            badEdgesCopy.splice(badEdgesCopy.end(), findMST(subgraph, treeHeight, t > 1 ? t - 1 : t));
+        statistics.subgraphsNumber += graphs.size();
+
+        if (parallel && graphs.size() > 1) {
+            // subgraphs share only read-only data, each task has its own result buffer (and its own trees with bad edges)
+            vector<vector<int>> results(graphs.size());
+            vector<ChazelleStatistics> taskStatistics(graphs.size());
+            runTasks(graphs.size(), [&](size_t i) {
+                results[i] = findMST(graphs[i], treeHeight, taskStatistics[i], t > 1 ? t - 1 : t, false, depth + 1);
+                });
+
+            // merge in the same order as the serial version
+            for (size_t i = 0; i < results.size(); ++i) {
+                MoveAppend(badEdges, std::move(results[i]));
+                statistics.merge(taskStatistics[i]);
+            }
+        }
+        else {
+            for (auto& subgraph : graphs) {
+                MoveAppend(badEdges, findMST(subgraph, treeHeight, statistics, t > 1 ? t - 1 : t, false, depth + 1));
+            }
         }
 
         Graph newGraph{};
-        for (const auto& edgeIndex : badEdgesCopy)
+        for (const auto& edgeIndex : badEdges)
         {
             auto& originalEdge = graph.getEdge(edgeIndex);
             auto fi = graph.getRoot(originalEdge.i);
@@ -121,7 +190,7 @@ public:
             newGraph.addEdge(fi, fj, originalEdge.weight, edgeIndex);
         }
 
-        boruvkaResult.splice(boruvkaResult.end(), findMST(newGraph, treeHeight, t));
+        MoveAppend(boruvkaResult, findMST(newGraph, treeHeight, statistics, t, parallel, depth + 1));
        
         return boruvkaResult;
     }
@@ -130,9 +199,42 @@ public:
 
     double getDuration() { return m_duration; }
 
+    PhaseTimes getPhaseTimes() { return m_phases; }
+
+    size_t getR() const { return m_r; }
+
+    const ChazelleStatistics& getStatistics() const { return m_statistics; }
+
+    // visit(u, v, weight, id) for each MST edge, the id is the index of the edge in m_edges
+    template<typename Visit>
+    void forEachMSTEdge(Visit visit) {
+        for (int edgeIndex : m_result) {
+            visit(get<0>(m_edges[edgeIndex]), get<1>(m_edges[edgeIndex]), get<2>(m_edges[edgeIndex]), edgeIndex);
+        }
+    }
+
+    MSTResult<> getResult() {
+        vector<MSTEdge<>> edges;
+        edges.reserve(m_result.size());
+        forEachMSTEdge([&](int u, int v, int weight, int id) { edges.push_back({ u, v, weight, static_cast<uint64_t>(id) }); });
+        return buildMSTResult(static_cast<size_t>(m_nodesNumber), move(edges));
+    }
+
 private:
 	int m_nodesNumber{ 0 };
+    vector<vector<pair<int, int>>>* m_adjacencyList{ nullptr };
+
+    ChazelleOptions m_options{};
+    // soft heap parameter, the same for all trees in one run
+    size_t m_r{ 0 };
+
+    ChazelleStatistics m_statistics{};
+
+    // edges of the input, the MST is given by their indices
+    vector<tuple<int, int, int>> m_edges;
+    vector<int> m_result;
 
     size_t m_mstWeight{ 0 };
     double m_duration{ 0 };
+    PhaseTimes m_phases{};
 };
\ No newline at end of file
@@ -34,7 +34,7 @@ Graph::Graph(const vector<vector<int>>& adjacencyMatrix)
 }
 
 Graph::Graph(const vector<tuple<int, int, int>>& edges)
-    : m_unionFind(maxVertexId(edges))
+    : m_unionFind(maxVertexId(edges) + 1)
 {
     for (auto& [i, j, weight] : edges) {
         addEdge(i, j, weight);
@@ -83,13 +83,13 @@ void Graph::findValidEdges(function<void(const Edge&, int, int)> action)
     }
 }
 
-list<int> Graph::boruvkaPhase(int count, bool* noChanges){
+vector<int> Graph::boruvkaPhase(int count, bool* noChanges){
 
     if (noChanges) {
         *noChanges = false;
     }
 
-    list<int> result;
+    vector<int> result;
 
     // apply Boruvka step "count" times
     for (int phase = 0; phase < count; ++phase) {
@@ -3,7 +3,6 @@
 #include "../Utils/UnionFind.h"
 
 #include <functional>
-#include <list>
 #include <map>
 #include <optional>
 #include <ranges>
@@ -37,7 +36,7 @@ public:
     
     set<int> getNodes() { return m_unionFind.getComponents();  }
 
-    list<int> boruvkaPhase(int count = 1, bool* noChanges = nullptr);
+    vector<int> boruvkaPhase(int count = 1, bool* noChanges = nullptr);
     Edge& getEdge(int index) { return m_edges[index]; }  
 
     const auto& getEdges() const { return m_edges; }
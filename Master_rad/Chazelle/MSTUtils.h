@@ -10,9 +10,10 @@ class Graph;
 namespace MST
 {
     // Ackermann function implemented recursively using memoization technique
+    // memo is per thread, so parallel Chazelle tasks do not race on it
     static uint32_t Ackermann(uint32_t i, uint32_t j)
     {
-        static std::map<uint32_t, std::map<uint32_t, std::optional<uint32_t>>> s_result{};
+        static thread_local std::map<uint32_t, std::map<uint32_t, std::optional<uint32_t>>> s_result{};
         auto& result = s_result[i][j];
         if (result.has_value())
             return result.value();
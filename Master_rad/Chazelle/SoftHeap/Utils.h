@@ -5,53 +5,33 @@
 #include <cmath>
 #include <functional>
 #include <iostream>
+#include <list>
 #include <ranges>
 #include <vector>
 
 namespace
 {
-    inline size_t CalculateRByEps(double eps)
-    {
-        return static_cast<size_t>(2.0 + 2.0 * std::ceil(std::log(1.0 / eps)));
-    }
-
-    template<typename SoftHeap>
-    int SoftHeapSelect(std::vector<int> a, int k)
+    // appends all elements of "from" to the end of "to", "from" is left empty
+    template<typename T>
+    void MoveAppend(std::vector<T>& to, std::vector<T>&& from)
     {
-        if (a.size() <= 3)
+        if (to.empty())
         {
-            std::ranges::nth_element(a, a.begin() + k);
-            return a[k];
+            to = std::move(from);
         }
-
-        SoftHeap heap(CalculateRByEps(1.0 / 3.0));
-        for (auto& v : a)
-            heap.Insert(v);
-
-        int max_value = -1;
-        for (int i = 0; i < static_cast<int>(a.size() / 3); ++i)
+        else
         {
-            auto removed = heap.DeleteMin();
-            if (removed >= max_value)
-                max_value = removed;
+            // element by element, some items (like EdgePtrWrapper) are not assignable
+            // capacity still grows geometrically when appending many times
+            const auto required = to.size() + from.size();
+            if (to.capacity() < required)
+                to.reserve(std::max(required, 2 * to.capacity()));
+            for (auto& value : from)
+                to.emplace_back(std::move(value));
         }
-
-        const auto partition_itr = std::partition(a.begin(), a.end(), [&](int value) { return value < max_value; });
-        const auto partition_index = std::distance(a.begin(), partition_itr);
-
-        if (partition_index == k)
-            return max_value;
-
-        if (k < partition_index)
-            return SoftHeapSelect<SoftHeap>(std::vector<int>{a.begin(), partition_itr}, k);
-
-        // Move max_value to the correct position
-        std::partition(partition_itr, a.end(), [&](int value) { return value <= max_value; });
-
-        return SoftHeapSelect<SoftHeap>(std::vector<int>{partition_itr + 1, a.end()}, k - (partition_index + 1));
+        from.clear();
     }
 
-
     template<typename Rng, typename T>
     bool IsRangeContains(const Rng& rng, const T& value)
     {
@@ -120,33 +100,3 @@ namespace
     LazyList(typename std::list<T>::const_iterator begin, typename std::list<T>::const_iterator end) -> LazyList<T>;
 
 } // namespace
-
-namespace Utils
-{
-    template<typename CoreType>
-    class ComparableObject
-    {
-    public:
-        ComparableObject(const CoreType* value)
-            : m_value(value) {
-        }
-
-        bool operator<(const ComparableObject& rhs) const
-        {
-            if (!m_value) // aka infinity < const_value
-                return false;
-
-            if (!rhs.m_value) // aka const_value < infinity
-                return true;
-
-            return *m_value < *rhs.m_value;
-        }
-
-
-        bool operator>(const ComparableObject& rhs) const { return rhs < *this; }
-
-        const CoreType* Get() const { return m_value; }
-    private:
-        const CoreType* m_value;
-    };
-}
\ No newline at end of file
@@ -4,7 +4,7 @@
 #include <algorithm>
 
 // r - soft heap error rate
-SoftHeapDecorator::SoftHeapDecorator(size_t r, set<size_t>& badEdges)
+SoftHeapDecorator::SoftHeapDecorator(size_t r, CorruptedEdges& badEdges)
     : m_heap{ r,
                 // callback that is called when weight of some edge is corrupted (increased)
                 // this lambda has a reference to the badEdges
@@ -15,7 +15,8 @@ SoftHeapDecorator::SoftHeapDecorator(size_t r, set<size_t>& badEdges)
                         // edge is corrupted if weight (cost) is different for the same key
                         edgeInfo.sharedPointer->setIsCorrupted(true);
                         // put original index to badEdges
-                        badEdges.emplace(edgeInfo.sharedPointer->getEdge().index);
+                        badEdges.indices.emplace(edgeInfo.sharedPointer->getEdge().index);
+                        badEdges.corruptionsNumber++;
                     }
                     edgeInfo.sharedPointer->setWorkingCost(changedEdgeInfo.sharedPointer->getWorkingCost());
                 }
@@ -40,11 +41,12 @@ EdgePtrWrapper SoftHeapDecorator::deleteMin()
     auto ptr = value.sharedPointer;
 
     // if it's already removed from local edges, find the new one
-    if (!IsRangeContains(m_items, value.sharedPointer)) {
+    auto itr = std::ranges::find(m_items, ptr);
+    if (itr == m_items.end()) {
         return deleteMin();
     }
 
-    m_items.remove(ptr);
+    m_items.erase(itr);
     return *ptr;
 }
 
@@ -65,32 +67,37 @@ EdgePtrWrapper* SoftHeapDecorator::findMin()
     return findMin();
 }
 
-list<EdgePtrWrapper> SoftHeapDecorator::deleteAndReturnIf(const function<bool(const EdgePtrWrapper& edge)>& func)
+vector<EdgePtrWrapper> SoftHeapDecorator::deleteAndReturnIf(const function<bool(const EdgePtrWrapper& edge)>& func)
 {
-    list<EdgePtrWrapper> result{};
+    vector<EdgePtrWrapper> result{};
 
     // go through all the items and remove them from the local list if satisfy func and add them to result
-    for (auto itr = m_items.begin(); itr != m_items.end();){
+    // the remaining items are compacted in place, their order is kept
+    auto kept = m_items.begin();
+    for (auto itr = m_items.begin(); itr != m_items.end(); ++itr){
         if (func(**itr)){
             result.emplace_back(**itr);
-            itr = m_items.erase(itr);
         }
-        else
-            ++itr;
+        else {
+            *kept++ = std::move(*itr);
+        }
     }
+    m_items.erase(kept, m_items.end());
+
     return result;
 }
 
 // merge two heaps
 void SoftHeapDecorator::meld(SoftHeapDecorator& other)
 {
-    m_items.splice(m_items.end(), other.m_items);
+    MoveAppend(m_items, std::move(other.m_items));
     m_heap.Meld(other.m_heap);
 }
 
 SoftHeapDecorator::ExtractedItems SoftHeapDecorator::extractItems()
 {
     ExtractedItems edges{};
+    edges.items.reserve(m_items.size());
 
     for (auto& edge : m_items){
         if (edge->getIsCorrupted()) {
@@ -1,11 +1,12 @@
 #pragma once
 #include "./Graph.h"
-#include "./SoftHeap/SoftHeap.h"
+#include "../Utils/SoftHeap.h"
 
 #include <array>
 #include <optional>
 #include <ostream>
 #include <set>
+#include <vector>
 
 using namespace std;
 
@@ -59,16 +60,25 @@ struct EdgePtrWrapperShared
     std::shared_ptr<EdgePtrWrapper> sharedPointer;
 };
 
+// edges whose working cost has been raised by the soft heaps of one tree
+struct CorruptedEdges
+{
+    // original indices of the corrupted (bad) edges
+    set<size_t> indices{};
+    // number of raised working costs, the same edge can be corrupted more than once
+    size_t corruptionsNumber{ 0 };
+};
+
 class SoftHeapDecorator
 {
 public:
     // this decorator is used by soft heap in order to work with edges
-    explicit SoftHeapDecorator(size_t r, set<size_t>& badEdges);
+    explicit SoftHeapDecorator(size_t r, CorruptedEdges& badEdges);
 
     struct ExtractedItems
     {
-        list<EdgePtrWrapper> corrupted{};
-        list<EdgePtrWrapper> items{};
+        vector<EdgePtrWrapper> corrupted{};
+        vector<EdgePtrWrapper> items{};
     };
 
     // insert edge 
@@ -80,9 +90,9 @@ public:
     EdgePtrWrapper  deleteMin();
     EdgePtrWrapper* findMin();
 
-    list<EdgePtrWrapper> deleteAndReturnIf(const function<bool(const EdgePtrWrapper& edge)>& func);
+    vector<EdgePtrWrapper> deleteAndReturnIf(const function<bool(const EdgePtrWrapper& edge)>& func);
 
 private:
     SoftHeap<EdgePtrWrapperShared> m_heap;
-    list<shared_ptr<EdgePtrWrapper>> m_items{};
+    vector<shared_ptr<EdgePtrWrapper>> m_items{};
 };
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+using namespace std;
+
+// counters collected during one run of Chazelle's algorithm
+// they are used to find the soft heap error rate (epsilon) that gives the best total time
+struct ChazelleStatistics
+{
+    // number of raised working costs in all soft heaps
+    size_t corruptionsNumber{ 0 };
+    // number of distinct corrupted (bad) edges
+    size_t corruptedEdgesNumber{ 0 };
+    // number of trees (active paths) built by TreeBuilder
+    size_t treesNumber{ 0 };
+    // number of subgraphs the recursion has been applied to
+    size_t subgraphsNumber{ 0 };
+    // the deepest recursive call of findMST, the first call has depth 0
+    size_t recursionDepth{ 0 };
+    // total size of the bad edge sets for each recursion depth
+    vector<size_t> badEdgesPerLevel{};
+
+    void addBadEdges(size_t depth, size_t count)
+    {
+        if (badEdgesPerLevel.size() <= depth) {
+            badEdgesPerLevel.resize(depth + 1, 0);
+        }
+        badEdgesPerLevel[depth] += count;
+    }
+
+    // used to combine results of the parallel tasks
+    void merge(const ChazelleStatistics& other)
+    {
+        corruptionsNumber += other.corruptionsNumber;
+        corruptedEdgesNumber += other.corruptedEdgesNumber;
+        treesNumber += other.treesNumber;
+        subgraphsNumber += other.subgraphsNumber;
+        recursionDepth = max(recursionDepth, other.recursionDepth);
+
+        for (size_t depth = 0; depth < other.badEdgesPerLevel.size(); ++depth) {
+            addBadEdges(depth, other.badEdgesPerLevel[depth]);
+        }
+    }
+};
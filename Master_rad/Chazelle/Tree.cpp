@@ -20,9 +20,9 @@ static vector<size_t> initTargetSizesPerHeight(size_t t, size_t maxHeight)
     return targetSizePerHeight;
 }
 
-Tree::Tree(Graph& graph, size_t t, size_t maxHeight, size_t initialVertex)
+Tree::Tree(Graph& graph, size_t t, size_t maxHeight, size_t initialVertex, size_t r)
     : m_graph{ graph }
-    , m_r{ CalculateRByEps(1 / static_cast<double>(MST::c)) }
+    , m_r{ r }
     , m_sizesPerHeight{ initTargetSizesPerHeight(t, maxHeight) }
 {
     pushNode(initialVertex);
@@ -30,7 +30,8 @@ Tree::Tree(Graph& graph, size_t t, size_t maxHeight, size_t initialVertex)
 
 void Tree::push(const EdgePtrWrapper& extensionEdge)
 {
-    auto& last = m_activePath.back();
+    // copy of the pointer, pushNode reallocates the active path
+    auto last = m_activePath.back();
     pushNode(extensionEdge.getOutsideVertex());
 
     last->addChild(extensionEdge->index, m_activePath.back());
@@ -38,10 +39,11 @@ void Tree::push(const EdgePtrWrapper& extensionEdge)
 
 SoftHeapDecorator::ExtractedItems Tree::pop()
 {
-    auto& lastSubgraph = m_activePath.back();
+    // copy of the pointer, a new root can be inserted in front of it
+    auto lastSubgraph = m_activePath.back();
 
     if (m_activePath.size() == 1){
-        m_activePath.emplace_front(std::make_shared<SubGraph>(lastSubgraph,
+        m_activePath.emplace(m_activePath.begin(), std::make_shared<SubGraph>(lastSubgraph,
             m_sizesPerHeight[indexToHeight(lastSubgraph->getLevelInTree() - 1)],
             m_r, m_badEdges));
     }
@@ -58,7 +60,7 @@ SoftHeapDecorator::ExtractedItems Tree::pop()
     return data;
 }
 
-SoftHeapDecorator::ExtractedItems Tree::fusion(list<SubGraphPtr>::iterator itr, const EdgePtrWrapper& fusionEdge)
+SoftHeapDecorator::ExtractedItems Tree::fusion(vector<SubGraphPtr>::iterator itr, const EdgePtrWrapper& fusionEdge)
 {
     auto popCount = distance(itr, m_activePath.end()) - 1;
 
@@ -67,8 +69,8 @@ SoftHeapDecorator::ExtractedItems Tree::fusion(list<SubGraphPtr>::iterator itr,
     for (size_t i = 0; i < popCount; ++i){
         auto data = pop();
 
-        items.corrupted.splice(items.corrupted.end(), data.corrupted);
-        items.items.splice(items.items.end(), data.items);
+        MoveAppend(items.corrupted, std::move(data.corrupted));
+        MoveAppend(items.items, std::move(data.items));
     }
 
     auto lastChild = m_activePath.back()->popLastChild();
@@ -83,7 +85,7 @@ SoftHeapDecorator::ExtractedItems Tree::fusion(list<SubGraphPtr>::iterator itr,
             return IsRangeContains(vertices, i) || IsRangeContains(vertices, j);
         });
 
-    assert(child_itr != childs.end());
+    assert(child_itr != children.end());
 
     (*child_itr)->addChild(fusionEdge->index, lastChild);
     return items;
@@ -100,14 +102,16 @@ size_t Tree::size() const {
     return m_activePath.empty() ? 0 : m_activePath.back()->getLevelInTree() + 1;
 }
 
-list<Graph> Tree::createSubGraphs(const std::set<size_t>& badEdges)
+vector<Graph> Tree::createSubGraphs(const std::set<size_t>& badEdges)
 {
-    list<SubGraphPtr> listOfSubgraphs{ m_activePath.front() };
-    list<Graph> result{};
+    // breadth-first traversal of the tree, processed subgraphs stay in the vector
+    vector<SubGraphPtr> listOfSubgraphs{ m_activePath.front() };
+    vector<Graph> result{};
 
-    while (!listOfSubgraphs.empty()){
+    for (size_t next = 0; next < listOfSubgraphs.size(); ++next){
 
-        auto& front = listOfSubgraphs.front();
+        // copy of the pointer, children are appended to the same vector
+        auto front = listOfSubgraphs[next];
         auto& graph = result.emplace_back();
 
         for (const auto& edgeIndex : front->getChildrenEdges()){
@@ -135,13 +139,11 @@ list<Graph> Tree::createSubGraphs(const std::set<size_t>& badEdges)
         if (graph.getNodesNumber() <= 1) {
             result.pop_back();
         }
-
-        listOfSubgraphs.pop_front();
     }
     return result;
 }
 
-list<size_t> Tree::getVerticesInside()
+vector<size_t> Tree::getVerticesInside()
 {
     return m_activePath.front()->getVertices(true);
 }
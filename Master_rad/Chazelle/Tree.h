@@ -11,14 +11,15 @@
 class Tree
 {
 public:
-    Tree(Graph& graph, size_t t, size_t maxHeight, size_t initialNode);
+    // r - soft heap error rate parameter, derived from epsilon
+    Tree(Graph& graph, size_t t, size_t maxHeight, size_t initialNode, size_t r);
 
     // extends the active path adding the next component via extensionEdge
     void push(const EdgePtrWrapper& extensionEdge);
 
     // retract the active path (melds the last and the previous component from the active path)
     SoftHeapDecorator::ExtractedItems pop();
-    SoftHeapDecorator::ExtractedItems fusion(list<SubGraphPtr>::iterator itr, const EdgePtrWrapper& fusionEdge);
+    SoftHeapDecorator::ExtractedItems fusion(vector<SubGraphPtr>::iterator itr, const EdgePtrWrapper& fusionEdge);
 
     // take the current (the last one) component on the active path
     ISubGraph& top();
@@ -43,11 +44,13 @@ public:
     }
 
     // Divide the graph by badEdges and apply recursion to the remaining parts of the original graph
-    list<Graph> createSubGraphs(const set<size_t>& badEdges);
+    vector<Graph> createSubGraphs(const set<size_t>& badEdges);
 
     // get all vertices from the current tree
-    list<size_t> getVerticesInside();
-    const set<size_t>& getBadEdges() const { return m_badEdges; }
+    vector<size_t> getVerticesInside();
+    const set<size_t>& getBadEdges() const { return m_badEdges.indices; }
+    // number of raised working costs in all heaps of this tree
+    size_t getCorruptionsNumber() const { return m_badEdges.corruptionsNumber; }
 
 private:
     // add new subGraph (which starts with vertex) to the m_activePath 
@@ -68,7 +71,7 @@ private:
     const size_t m_r;
 
     // all the components in the active path
-    list<SubGraphPtr> m_activePath{};
-    set<size_t> m_badEdges{};
+    vector<SubGraphPtr> m_activePath{};
+    CorruptedEdges m_badEdges{};
     const vector<size_t> m_sizesPerHeight;
 };
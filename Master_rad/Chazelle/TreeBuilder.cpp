@@ -2,9 +2,9 @@
 
 #include "Graph.h"
 
-TreeBuilder::TreeBuilder(Graph& graph, size_t t, size_t maxHeight, size_t initialVertex)
+TreeBuilder::TreeBuilder(Graph& graph, size_t t, size_t maxHeight, size_t initialVertex, size_t r)
     : m_graph{ graph }
-    , m_tree{ m_graph, t, maxHeight, initialVertex }
+    , m_tree{ m_graph, t, maxHeight, initialVertex, r }
 {
     while (true){
         if (m_tree.top().satisfiedTargetSize()){
@@ -44,7 +44,7 @@ bool TreeBuilder::extension()
     return true;
 }
 
-void TreeBuilder::createClustersAndPushCheapest(list<EdgePtrWrapper>&& items)
+void TreeBuilder::createClustersAndPushCheapest(vector<EdgePtrWrapper>&& items)
 {
     // cluster based on outer vertex
     map<size_t, set<EdgePtrWrapper>> clusters{};
@@ -8,7 +8,7 @@
 class TreeBuilder
 {
 public:
-    TreeBuilder(Graph& graph, size_t t, size_t maxHeight, size_t initialVertex);
+    TreeBuilder(Graph& graph, size_t t, size_t maxHeight, size_t initialVertex, size_t r);
 
     Tree& getTree() { return m_tree; }
 private:
@@ -16,7 +16,7 @@ private:
     bool retraction();
     bool extension();
 
-    void createClustersAndPushCheapest(list<EdgePtrWrapper>&& items);
+    void createClustersAndPushCheapest(vector<EdgePtrWrapper>&& items);
     SoftHeapDecorator* findHeapWithExtensionEdge();
 
     SoftHeapDecorator::ExtractedItems fusion(EdgePtrWrapper& edge);
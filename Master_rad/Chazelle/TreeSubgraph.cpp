@@ -2,7 +2,7 @@
 #include "SoftHeap/Utils.h"
 
 
-SubGraph::SubGraph(size_t vertex, size_t levelInTree, size_t targetSize, size_t r, set<size_t>& badEdges)
+SubGraph::SubGraph(size_t vertex, size_t levelInTree, size_t targetSize, size_t r, CorruptedEdges& badEdges)
     : m_vertex{ vertex }
     , m_levelInTree{ levelInTree }
     , m_targetSize{ targetSize }
@@ -12,7 +12,7 @@ SubGraph::SubGraph(size_t vertex, size_t levelInTree, size_t targetSize, size_t
     initHeaps();
 }
 
-SubGraph::SubGraph(const SubGraphPtr& child, size_t targetSize, size_t r, set<size_t>& badEdges)
+SubGraph::SubGraph(const SubGraphPtr& child, size_t targetSize, size_t r, CorruptedEdges& badEdges)
     : m_levelInTree{ child->getLevelInTree() - 1 }
     , m_targetSize{ targetSize }
     , m_r{ r }
@@ -45,7 +45,7 @@ bool SubGraph::satisfiedTargetSize() const
     return m_vertex.has_value() ? true : m_children.size() >= m_targetSize;
 }
 
-list<size_t> SubGraph::getVertices(bool cache)
+vector<size_t> SubGraph::getVertices(bool cache)
 {
     assert(m_vertex.has_value() && m_children.empty() || !m_vertex.has_value() && !m_children.empty());
 
@@ -56,11 +56,11 @@ list<size_t> SubGraph::getVertices(bool cache)
     if (cache && !m_cachedVertices.empty())
         return m_cachedVertices;
 
-    list<size_t> result{};
+    vector<size_t> result{};
 
     for (const auto& child : m_children) {
         // apply recursion to the children
-        result.splice(result.end(), child.second->getVertices(cache));
+        MoveAppend(result, child.second->getVertices(cache));
     }
 
     if (cache) {
@@ -106,8 +106,8 @@ SoftHeapDecorator::ExtractedItems SubGraph::extractItems()
         [&](SoftHeapDecorator& heap)
         {
             auto heap_data = heap.extractItems();
-            data.corrupted.splice(data.corrupted.end(), heap_data.corrupted);
-            data.items.splice(data.items.end(), heap_data.items);
+            MoveAppend(data.corrupted, std::move(heap_data.corrupted));
+            MoveAppend(data.items, std::move(heap_data.items));
         });
 
     // clear heaps and prepare fot the next phase
@@ -150,12 +150,12 @@ SoftHeapDecorator* SubGraph::findHeapWithMin()
 }
 
 
-list<EdgePtrWrapper> SubGraph::deleteAndReturnIf(const function<bool(const EdgePtrWrapper& edge)>& func)
+vector<EdgePtrWrapper> SubGraph::deleteAndReturnIf(const function<bool(const EdgePtrWrapper& edge)>& func)
 {
-    list<EdgePtrWrapper> result{};
+    vector<EdgePtrWrapper> result{};
     
     for (auto& heap : m_heaps) {
-        result.splice(result.end(), heap.deleteAndReturnIf(func));
+        MoveAppend(result, heap.deleteAndReturnIf(func));
     }
     return result;
 }
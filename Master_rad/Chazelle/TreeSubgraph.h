@@ -22,7 +22,7 @@ struct ISubGraph
     // there is specified limit of nodes number for each level, tree construction stops when the specified limit is met
     virtual bool satisfiedTargetSize() const = 0;
 
-    virtual list<size_t> getVertices(bool cache = false) = 0;
+    virtual vector<size_t> getVertices(bool cache = false) = 0;
     // minimum edges connected to the node (component) that will be next added to the active path
     virtual vector<EdgePtrWrapper> getMinLinks() const = 0;
 
@@ -39,9 +39,9 @@ class SubGraph : public ISubGraph
 {
 public:
     // creation of a new component, starts with only one node
-    SubGraph(size_t vertex, size_t levelInTree, size_t targetSize, size_t r, set<size_t>& badEdges);
+    SubGraph(size_t vertex, size_t levelInTree, size_t targetSize, size_t r, CorruptedEdges& badEdges);
     // creation of a new parent subgraph of existing children node (one level up in the tree)
-    SubGraph(const SubGraphPtr& child, size_t targetSize, size_t r, set<size_t>& badEdges);
+    SubGraph(const SubGraphPtr& child, size_t targetSize, size_t r, CorruptedEdges& badEdges);
 
     // copies mustn't be created, there is a shared ptr instead
     SubGraph(SubGraph&& other) = delete;
@@ -54,7 +54,7 @@ public:
     size_t getLevelInTree() const override;
     bool satisfiedTargetSize() const override;
     
-    list<size_t> getVertices(bool cache = false) override;
+    vector<size_t> getVertices(bool cache = false) override;
     vector<EdgePtrWrapper> getMinLinks() const { return m_minLinksToNextNodesInActivePath; }
 
     SoftHeapDecorator* findHeapWithMin() override;
@@ -80,7 +80,7 @@ public:
     }
 
     // delete edges from the heap when specific edge becomes intern edge, not border due to heaps melding
-    list<EdgePtrWrapper> deleteAndReturnIf(const function<bool(const EdgePtrWrapper& edge)>& func);
+    vector<EdgePtrWrapper> deleteAndReturnIf(const function<bool(const EdgePtrWrapper& edge)>& func);
 
 private:
     // initialize vector of heaps for this subtree
@@ -99,6 +99,6 @@ private:
     vector<SoftHeapDecorator> m_heaps;
     vector<EdgePtrWrapper> m_minLinksToNextNodesInActivePath{};
 
-    list<size_t> m_cachedVertices{};
-    set<size_t>& m_badEdges;
+    vector<size_t> m_cachedVertices{};
+    CorruptedEdges& m_badEdges;
 };
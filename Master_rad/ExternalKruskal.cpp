@@ -0,0 +1,352 @@
+#include "Utils/UnionFind.h"
+#include "Utils/PhaseTimer.h"
+#include "Utils/Log.h"
+#include "Utils/WeightTraits.h"
+#include "Utils/MSTResult.h"
+#include "Utils/ParallelSort.h"
+#include "GraphIO/EdgeStream.hpp"
+
+#include <vector>
+#include <queue>
+#include <iostream>
+#include <algorithm>
+#include <string>
+#include <cstdio>
+#include <cstdint>
+#include <chrono>
+#include <filesystem>
+#include <stdexcept>
+
+using namespace std;
+
+struct ExternalKruskalOptions {
+	// memory for the edges: a sorted run with the buffer of its sort and the sum of the merge buffers
+	size_t memoryBytes{ size_t{ 1 } << 30 };
+	// directory of the temporary runs, empty means the system temporary directory
+	string tempDirectory{};
+	// the smallest read of one run during the merge, more runs than memoryBytes / minBlockBytes are merged in several passes
+	size_t minBlockBytes{ size_t{ 4 } << 20 };
+	unsigned workersNumber{ 0 };
+};
+
+// Kruskal for edge files bigger than the memory (semi-external: the union-find of the nodes fits, the edges don't)
+// the file is read in runs of memoryBytes / 2 (the radix sort needs a buffer of the same size),
+// each run is sorted by weight and written to a temporary file before the next one is read,
+// then the runs are merged and the merged stream goes through the union-find
+// only the union-find, the forest and the run buffers are in memory and all files are read and written sequentially
+// a file that ends inside the first run is not written at all
+// the result is the minimum spanning forest when the graph is not connected
+class ExternalKruskalAlgorithm {
+	// the weights of the streams are int and can be negative
+	using Sum = WeightTraits<int>::Sum;
+
+public:
+	ExternalKruskalAlgorithm(const string& path, ExternalKruskalOptions options = {})
+		: m_options(options)
+		, m_reader(path)
+		, m_unionFind(static_cast<int>(m_reader.nodesNumber()))
+	{
+		m_runEdges = max<size_t>(1, m_options.memoryBytes / 2 / sizeof(mstio::StreamEdge));
+
+		PhaseTimer timer;
+		createRuns(timer);
+		mergeRuns(timer);
+		sumMST();
+		timer.finish(m_phases.materialization);
+
+		m_duration = m_phases.total();
+
+		MST_LOG(Debug, "ExternalKruskal: " << m_mstWeight);
+	}
+
+	ExternalKruskalAlgorithm(const ExternalKruskalAlgorithm&) = delete;
+	ExternalKruskalAlgorithm& operator=(const ExternalKruskalAlgorithm&) = delete;
+
+	double getDuration() { return m_duration; }
+
+	PhaseTimes getPhaseTimes() { return m_phases; }
+
+	Sum getMSTWeight() { return m_mstWeight; }
+
+	// number of edges of the forest, nodes - components
+	size_t getForestEdgesNumber() { return m_MST.size(); }
+
+	size_t getNodesNumber() { return m_reader.nodesNumber(); }
+
+	// visit(u, v, weight) for each forest edge
+	template<typename Visit>
+	void forEachMSTEdge(Visit visit) {
+		for (const auto& edge : m_MST) {
+			visit(edge.u, edge.v, edge.weight);
+		}
+	}
+
+	// the edges come from a stream, their ids are noEdgeId
+	MSTResult<> getResult() {
+		vector<MSTEdge<>> edges;
+		edges.reserve(m_MST.size());
+		forEachMSTEdge([&](int u, int v, int weight) { edges.push_back({ u, v, weight, noEdgeId }); });
+		return buildMSTResult(getNodesNumber(), move(edges));
+	}
+
+	// number of sorted runs written to the disk, 0 if the edges fit into memory
+	size_t getRunsNumber() { return m_runsNumber; }
+
+private:
+	// reading is the conversion, sorting and writing of the runs the preprocessing
+	void createRuns(PhaseTimer& timer) {
+		// reserved only, the pages are touched by the edges read, and the reads don't reallocate the run
+		vector<mstio::StreamEdge> run;
+		run.reserve(m_runEdges);
+
+		while (true) {
+			bool more = m_reader.read(run, m_runEdges);
+			timer.finish(m_phases.conversion);
+			if (!more) break;
+
+			// a run shorter than the limit is the last one
+			const bool last = run.size() < m_runEdges;
+			sortByWeight(run);
+
+			// the only run stays in memory, any other one is written before the next run is read
+			if (m_runs.empty() && last) {
+				m_memoryRun.swap(run);
+				timer.finish(m_phases.preprocessing);
+				break;
+			}
+			writeRun(run);
+			timer.finish(m_phases.preprocessing);
+			if (last) break;
+		}
+
+		m_runsNumber = m_runs.size();
+		m_unionFind.ensureSize(static_cast<int>(m_reader.nodesNumber()));
+	}
+
+	void mergeRuns(PhaseTimer& timer) {
+		if (m_runs.empty()) {
+			for (const auto& edge : m_memoryRun) {
+				if (addEdge(edge)) break;
+			}
+			m_memoryRun = {};
+			timer.finish(m_phases.core);
+			return;
+		}
+
+		// too many runs for the buffers are merged into longer ones first
+		const size_t fanIn = max<size_t>(2, m_options.memoryBytes / max<size_t>(1, m_options.minBlockBytes));
+		while (m_runs.size() > fanIn) {
+			vector<string> merged;
+			for (size_t first = 0; first < m_runs.size(); first += fanIn) {
+				vector<string> group(m_runs.begin() + first, m_runs.begin() + min(m_runs.size(), first + fanIn));
+				if (group.size() == 1) {
+					merged.push_back(group[0]);
+					continue;
+				}
+
+				const string path = runPath();
+				RunWriter writer(path);
+				merge(group, [&](const mstio::StreamEdge& edge) { writer.write(edge); return false; });
+				writer.close();
+				merged.push_back(path);
+				removeRuns(group);
+			}
+			m_runs = merged;
+		}
+		timer.finish(m_phases.preprocessing);
+
+		merge(m_runs, [&](const mstio::StreamEdge& edge) { return addEdge(edge); });
+		timer.finish(m_phases.core);
+	}
+
+	// returns true when the forest is a spanning tree and no other edge can be added
+	bool addEdge(const mstio::StreamEdge& edge) {
+		int fx = m_unionFind.find(edge.u);
+		int fy = m_unionFind.find(edge.v);
+
+		// add edge and connect components represented by fx and fy only if they are in different forests
+		if (fx != fy) {
+			m_unionFind.unionOperation(fx, fy);
+			m_MST.push_back(edge);
+		}
+		return m_MST.size() + 1 == m_reader.nodesNumber();
+	}
+
+	void sumMST() {
+		for (const auto& edge : m_MST) {
+			m_mstWeight += edge.weight;
+		}
+	}
+
+	void sortByWeight(vector<mstio::StreamEdge>& edges) {
+		// the sign bit is flipped, so negative weights come first
+		parallelRadixSort(edges, [](const mstio::StreamEdge& edge) { return static_cast<uint64_t>(static_cast<uint32_t>(edge.weight) ^ 0x80000000u); },
+			m_options.workersNumber);
+	}
+
+	// k-way merge of the sorted runs, consume(edge) returns true to stop
+	template<typename Consume>
+	void merge(const vector<string>& runs, Consume consume) {
+		const size_t blockEdges = max<size_t>(1, m_options.memoryBytes / runs.size() / sizeof(mstio::StreamEdge));
+
+		vector<RunReader> readers;
+		readers.reserve(runs.size());
+		for (const auto& run : runs) {
+			readers.emplace_back(run, blockEdges);
+		}
+
+		// (weight, run)
+		priority_queue<pair<int, size_t>, vector<pair<int, size_t>>, greater<pair<int, size_t>>> heads;
+		for (size_t i = 0; i < readers.size(); ++i) {
+			if (readers[i].next()) heads.push({ readers[i].edge().weight, i });
+		}
+
+		while (!heads.empty()) {
+			size_t i = heads.top().second;
+			heads.pop();
+
+			if (consume(readers[i].edge())) return;
+			if (readers[i].next()) heads.push({ readers[i].edge().weight, i });
+		}
+	}
+
+	// sequential reader of a run in blocks
+	class RunReader {
+	public:
+		RunReader(const string& path, size_t blockEdges)
+			: m_path(path), m_file(fopen(path.c_str(), "rb")), m_block(blockEdges)
+		{
+			if (!m_file) throw runtime_error("can't open the run " + path);
+		}
+
+		RunReader(RunReader&& other) noexcept
+			: m_path(move(other.m_path)), m_file(other.m_file), m_block(move(other.m_block)), m_position(other.m_position), m_size(other.m_size)
+		{
+			other.m_file = nullptr;
+		}
+
+		~RunReader() { if (m_file) fclose(m_file); }
+
+		// moves to the next edge, false at the end of the run
+		bool next() {
+			if (++m_position < m_size) return true;
+
+			m_size = fread(m_block.data(), sizeof(mstio::StreamEdge), m_block.size(), m_file);
+			if (m_size < m_block.size() && ferror(m_file)) throw runtime_error("can't read the run " + m_path);
+			m_position = 0;
+			return m_size > 0;
+		}
+
+		const mstio::StreamEdge& edge() const { return m_block[m_position]; }
+
+	private:
+		string m_path;
+		FILE* m_file{ nullptr };
+		vector<mstio::StreamEdge> m_block;
+		size_t m_position{ 0 };
+		size_t m_size{ 0 };
+	};
+
+	// removes the files it was given when it's destroyed, also when the constructor of the algorithm throws
+	class TemporaryFiles {
+	public:
+		TemporaryFiles() = default;
+		TemporaryFiles(const TemporaryFiles&) = delete;
+		TemporaryFiles& operator=(const TemporaryFiles&) = delete;
+
+		~TemporaryFiles() {
+			for (const auto& path : m_paths) {
+				error_code error;
+				filesystem::remove(path, error);
+			}
+		}
+
+		void add(const string& path) { m_paths.push_back(path); }
+
+	private:
+		vector<string> m_paths;
+	};
+
+	class RunWriter {
+	public:
+		RunWriter(const string& path) : m_path(path), m_file(fopen(path.c_str(), "wb")) {
+			if (!m_file) throw runtime_error("can't create the run " + path);
+			m_block.reserve((size_t{ 4 } << 20) / sizeof(mstio::StreamEdge));
+		}
+
+		~RunWriter() { if (m_file) fclose(m_file); }
+
+		void write(const mstio::StreamEdge& edge) {
+			m_block.push_back(edge);
+			if (m_block.size() == m_block.capacity()) flush();
+		}
+
+		void close() {
+			flush();
+			bool closed = fclose(m_file) == 0;
+			m_file = nullptr;
+			if (!closed) throw runtime_error("can't write the run " + m_path);
+		}
+
+	private:
+		void flush() {
+			if (fwrite(m_block.data(), sizeof(mstio::StreamEdge), m_block.size(), m_file) != m_block.size()) {
+				throw runtime_error("can't write the run " + m_path);
+			}
+			m_block.clear();
+		}
+
+		string m_path;
+		FILE* m_file{ nullptr };
+		vector<mstio::StreamEdge> m_block;
+	};
+
+	void writeRun(const vector<mstio::StreamEdge>& run) {
+		const string path = runPath();
+		m_runs.push_back(path);
+
+		FILE* file = fopen(path.c_str(), "wb");
+		if (!file) throw runtime_error("can't create the run " + path);
+		bool written = fwrite(run.data(), sizeof(mstio::StreamEdge), run.size(), file) == run.size();
+		if (fclose(file) != 0 || !written) throw runtime_error("can't write the run " + path);
+	}
+
+	void removeRuns(const vector<string>& runs) {
+		for (const auto& run : runs) {
+			error_code error;
+			filesystem::remove(run, error);
+		}
+	}
+
+	// unique name in the temporary directory, the file is removed with the algorithm at the latest
+	string runPath() {
+		const filesystem::path directory = m_options.tempDirectory.empty() ? filesystem::temp_directory_path() : filesystem::path(m_options.tempDirectory);
+		const auto stamp = chrono::steady_clock::now().time_since_epoch().count();
+		const string path = (directory / ("mst-run-" + to_string(stamp) + "-" + to_string(m_nextRun++) + ".tmp")).string();
+		m_temporaryFiles.add(path);
+		return path;
+	}
+
+private:
+	ExternalKruskalOptions m_options;
+	mstio::EdgeStreamReader m_reader;
+	size_t m_runEdges{ 0 };
+
+	Sum m_mstWeight{ 0 };
+	double m_duration{ 0 };
+	PhaseTimes m_phases{};
+
+	// the only run when the edges fit into memory
+	vector<mstio::StreamEdge> m_memoryRun;
+	// all temporary files, the runs merged before are removed right away
+	TemporaryFiles m_temporaryFiles;
+	// temporary files of the sorted runs
+	vector<string> m_runs;
+	size_t m_runsNumber{ 0 };
+	size_t m_nextRun{ 0 };
+
+	vector<mstio::StreamEdge> m_MST;
+
+	// used for merging different connected componnets
+	UnionFind m_unionFind;
+};
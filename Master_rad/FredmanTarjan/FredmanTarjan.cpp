@@ -1,11 +1,14 @@
-#include "../Utils/UnionFind.h"
+#include "../Utils/IndexedHeap.h"
 #include "../Utils/FibonacciHeap.cpp"
+#include "../Utils/PhaseTimer.h"
+#include "../Utils/Log.h"
+#include "../Utils/MSTResult.h"
 
 #include <vector>
-#include <queue>
 #include <iostream>
 #include <algorithm>
-#include <unordered_set>
+#include <cstdint>
+#include <tuple>
 
 #include <chrono>
 
@@ -14,196 +17,270 @@ using namespace std;
 using Clock = std::chrono::steady_clock;
 using ms = std::chrono::duration<double, std::milli>;
 
+// Heap is one of the heaps from IndexedHeap.h (DaryHeap, PairingHeap, RankPairingHeap) or FibonacciHeap
+// all of them are indexed by the (contracted) vertex id, so the algorithm itself works only with flat arrays
+template<typename Heap = PairingHeap>
 class FredmanTarjan {
 public:
+	// an engine kept for many graphs (Utils/MSTEngine.h) calls prepare and solve for each of them
+	FredmanTarjan() = default;
+
 	FredmanTarjan(vector<vector<pair<int, int>>>& adjacencyList)
-		: m_nodesNumber(adjacencyList.size())
  	{
-		// initialize m_adjacencyList
-		for (int i = 0; i < adjacencyList.size(); ++i) {
-			m_nodes.insert(i);
-			unordered_map<int, int> currentNeighbors = {};
+		prepare(adjacencyList);
+		solve();
+
+		MST_LOG(Debug, "Fredman-Tarjan: " << m_mstWeight);
+	}
+
+	// binds the graph, the edge lists, the CSR arrays and the heap keep their memory from the previous graph
+	void prepare(vector<vector<pair<int, int>>>& adjacencyList) {
+		m_adjacencyList = &adjacencyList;
+		m_nodesNumber = adjacencyList.size();
+		m_heapSize = 0;
+		m_edges.clear();
+		m_result.clear();
+		m_mstWeight = 0;
+		m_phases = {};
+	}
 
+	void solve() {
+		PhaseTimer timer;
+		const auto& adjacencyList = *m_adjacencyList;
+
+		// initialize list of edges, edge id is the position in m_edges
+		for (int i = 0; i < adjacencyList.size(); ++i) {
 			for (int j = 0; j < adjacencyList[i].size(); ++j) {
-				currentNeighbors.insert(adjacencyList[i][j]);
 				// no need to consider both (i, adjacencyList[i][j].first) and (adjacencyList[i][j].first, i)
-				if (i < adjacencyList[i][j].first) m_edgesNumber++;
+				if (i < adjacencyList[i][j].first) m_edges.push_back({ i, adjacencyList[i][j].first, adjacencyList[i][j].second });
 			}
-			m_adjacencyList[i] = currentNeighbors;
 		}
+		m_edgesNumber = m_edges.size();
+		timer.finish(m_phases.conversion);
 
-		auto start = Clock::now();
-		UnionFind unionFind(m_nodesNumber);
-		findMST(unionFind);
-		auto end = Clock::now();
-
-		m_duration = std::chrono::duration_cast<ms>(end - start).count();
+		findMST();
+		timer.finish(m_phases.core);
 
 		printResult();
+		timer.finish(m_phases.materialization);
 
-		cout << "Fredman-Tarjan: " << m_mstWeight << endl;
+		m_duration = m_phases.total();
 	}
 
 public:
-	// unionFind parameter is a struct that has info about connected components
-	void findMST(UnionFind& unionFind) {
+	void findMST() {
+		int nodesNumber = m_nodesNumber;
+
+		// edges of the contracted graph, the first one has the original vertices
+		vector<ContractedEdge>& edges = m_contractedEdges;
+		edges.clear();
+		edges.reserve(m_edges.size());
+		for (size_t id = 0; id < m_edges.size(); ++id) {
+			edges.push_back({ get<0>(m_edges[id]), get<1>(m_edges[id]), get<2>(m_edges[id]), static_cast<int>(id) });
+		}
 
-		if (!m_heapSize) m_heapSize = max(1, m_edgesNumber / max(1, m_nodesNumber));
-		else m_heapSize = max(1, (int)pow(2, (double)m_heapSize));
+		// each pass contracts the graph, there are no edges left when MST (MSF) is found
+		while (!edges.empty()) {
+			buildGraph(nodesNumber, edges);
 
-		// all nodes that have been already added to the heap
-		unordered_set<int> visited;
+			if (!m_heapSize) m_heapSize = static_cast<size_t>(max(1, m_edgesNumber / max(1, m_nodesNumber)));
+			else m_heapSize = m_heapSize >= 63 ? SIZE_MAX : size_t{ 1 } << m_heapSize;
+			m_heapSize = min(m_heapSize, static_cast<size_t>(nodesNumber));
 
-		// go through all the nodes
-		for (int i = 0; i < m_nodesNumber; ++i) {
+			int treesNumber = growTrees(nodesNumber);
 
-			// process the node in case it's not been visited yet
-			if (visited.find(unionFind.find(i)) == visited.end()) {
+			// new id of each tree, trees connected to the older ones get the id of the older one
+			vector<int> treeId(treesNumber);
+			int newNodesNumber = 0;
+			for (int tree = 0; tree < treesNumber; ++tree) {
+				treeId[tree] = m_treeParent[tree] == tree ? newNodesNumber++ : treeId[m_treeParent[tree]];
+			}
 
-				fibonacciHeap heap;
-				fibonacciHeapHandle position;
+			contract(edges, treeId);
+			nodesNumber = newNodesNumber;
+		}
+	}
 
-				// reference to each element from the heap
-				unordered_map<int, fibonacciHeapHandle>nodePosition;
+	void printResult() {
 
-				// take all neighbors of the current node
-				const auto& neighbors = m_adjacencyList[i];
+		for (int id : m_result) {
+			//cout << "(" << get<0>(m_edges[id]) << ", " << get<1>(m_edges[id]) << ") weight: " << get<2>(m_edges[id]) << ")" << endl;
+			m_mstWeight += get<2>(m_edges[id]);
+		}
+	}
 
-				// go through all the neighbors of i
-				for (auto neighbor = neighbors.begin(); neighbor != neighbors.end(); neighbor++) {
-					auto currentPair = make_pair(neighbor->first, neighbor->second);
-					position = heap.emplace(currentPair);
+	size_t getMSTWeight() { return m_mstWeight; }
 
-					nodePosition[neighbor->first] = position;
-				}
+	double getDuration() { return m_duration; }
 
-				while (!heap.empty()) {
-					// take the top one, it's the cheapest one
-					auto currentNode = heap.top();
-
-					bool exceededHeapSize = heap.size() > m_heapSize;
-					bool currentNodeAlreadyVisited = visited.find(currentNode.first) != visited.end();
-					bool sameComponent = unionFind.connected(currentNode.first, i);
-
-					if (exceededHeapSize || currentNodeAlreadyVisited || sameComponent) break;
-
-					// marked as visited and can be removed from the heap
-					visited.insert(i);
-					visited.insert(currentNode.first);
-
-					heap.pop();
-
-					// the is processed successfully
-					m_result.push_back({ i, currentNode.first, currentNode.second });
-
-					// current node and it's parent can be merged - put the into the same component
-					unionFind.unionOperation(i, currentNode.first);
-				
-					// go through current's node neighbors
-					const auto& currentNodeNeighbors = m_adjacencyList[currentNode.first];
-					fibonacciHeapHandle currentPosition;
-
-					for (auto currentNodeNeighbor = currentNodeNeighbors.begin(); currentNodeNeighbor != currentNodeNeighbors.end(); currentNodeNeighbor++) {
-						
-						// shouldn't go back to the parent again
-						if (currentNodeNeighbor->first == i) continue;
-
-						// add nodes that have not been already added
-						if (nodePosition.find(currentNodeNeighbor->first) == nodePosition.end()) {
-							position = heap.emplace(make_pair(currentNodeNeighbor->first, currentNodeNeighbor->second));
-							nodePosition[currentNodeNeighbor->first] = position;
-						}
-						// update ones that have been already added
-						else {
-							// these shouldn't be processed before (maybe it's removed, it has to be checked)
-							if (visited.find(currentNodeNeighbor->first) == visited.end()) {
-								currentPosition = nodePosition[currentNodeNeighbor->first];
-
-								if ((*currentPosition).second > (*currentNodeNeighbor).second) {
-									heap.update(currentPosition, make_pair(currentNodeNeighbor->first, currentNodeNeighbor->second));
-								}
-							}
-						}
-					}
+	PhaseTimes getPhaseTimes() { return m_phases; }
 
+	// visit(u, v, weight, id) for each MST edge, the id is the position in m_edges
+	template<typename Visit>
+	void forEachMSTEdge(Visit visit) {
+		for (int id : m_result) {
+			visit(get<0>(m_edges[id]), get<1>(m_edges[id]), get<2>(m_edges[id]), id);
+		}
+	}
+
+	MSTResult<> getResult() {
+		vector<MSTEdge<>> edges;
+		edges.reserve(m_result.size());
+		forEachMSTEdge([&](int u, int v, int weight, int id) { edges.push_back({ u, v, weight, static_cast<uint64_t>(id) }); });
+		return buildMSTResult(static_cast<size_t>(m_nodesNumber), move(edges));
+	}
+
+private:
+	struct ContractedEdge {
+		int from;
+		int to;
+		int weight;
+		// position in m_edges
+		int id;
+	};
+
+	// CSR of the current contracted graph, both directions of each edge are stored
+	void buildGraph(int nodesNumber, const vector<ContractedEdge>& edges) {
+		m_offsets.assign(nodesNumber + 1, 0);
+		for (const auto& edge : edges) {
+			m_offsets[edge.from + 1]++;
+			m_offsets[edge.to + 1]++;
+		}
+		for (int i = 0; i < nodesNumber; ++i) {
+			m_offsets[i + 1] += m_offsets[i];
+		}
+
+		m_targets.resize(2 * edges.size());
+		m_weights.resize(2 * edges.size());
+		m_edgeIds.resize(2 * edges.size());
+
+		vector<int> next(m_offsets.begin(), m_offsets.end() - 1);
+		auto add = [&](int from, int to, const ContractedEdge& edge) {
+			int position = next[from]++;
+			m_targets[position] = to;
+			m_weights[position] = edge.weight;
+			m_edgeIds[position] = edge.id;
+		};
+
+		for (const auto& edge : edges) {
+			add(edge.from, edge.to, edge);
+			add(edge.to, edge.from, edge);
+		}
+	}
+
+	// grows trees one by one until the heap gets bigger than m_heapSize or the tree reaches an older tree
+	// all the cheapest edges used to grow are added to the result, returns the number of trees
+	int growTrees(int nodesNumber) {
+		m_tree.assign(nodesNumber, -1);
+		m_treeParent.clear();
+		m_cheapestEdge.resize(nodesNumber);
+		m_heap.reset(nodesNumber);
+
+		for (int i = 0; i < nodesNumber; ++i) {
+			if (m_tree[i] != -1) continue;
+
+			int tree = static_cast<int>(m_treeParent.size());
+			m_treeParent.push_back(tree);
+			m_tree[i] = tree;
+			addNeighbors(i, tree);
+
+			// at least one edge is taken, so every tree that has neighbors gets contracted
+			while (!m_heap.empty()) {
+				// the cheapest edge leaving the current tree
+				int node = m_heap.top().first;
+				m_heap.pop();
+				m_result.push_back(m_cheapestEdge[node]);
+
+				// the current tree is connected to the older one, they will be contracted together
+				if (m_tree[node] != -1) {
+					m_treeParent[tree] = m_tree[node];
+					break;
 				}
 
+				m_tree[node] = tree;
+				addNeighbors(node, tree);
+
+				if (m_heap.size() > m_heapSize) break;
 			}
 
+			m_heap.clear();
 		}
 
-		// only one component has left - MST is created, otherwise contraction and recursive call must be done
-		if (unionFind.getComponentNumber() == 1) return;
+		return static_cast<int>(m_treeParent.size());
+	}
+
+	void addNeighbors(int node, int tree) {
+		for (int position = m_offsets[node]; position < m_offsets[node + 1]; ++position) {
+			int neighbor = m_targets[position];
+			int weight = m_weights[position];
 
-		unordered_map<int, unordered_map<int, int>> newAdjacencyList;
-		unordered_set<int> newNodes;
+			// shouldn't go back to the current tree
+			if (m_tree[neighbor] == tree) continue;
 
-		// update set of nodes using unionFind
-		// go through current set of nodes
-		for (auto& node : m_nodes) {
-			int component = unionFind.find(node);
-			// insert only if the current node is not already added
-			if (newNodes.find(component) == newNodes.end()) {
-				newNodes.insert(component);
+			if (!m_heap.contains(neighbor)) {
+				m_heap.push(neighbor, weight);
+				m_cheapestEdge[neighbor] = m_edgeIds[position];
 			}
-		}
-		m_nodes = newNodes;
-
-
-		unordered_map<int, int> neighbors;
-		// initialization of newAdjacency list
-		for (auto it = newNodes.begin(); it != newNodes.end(); it++)
-			newAdjacencyList[*it] = neighbors;
-
-		// go through initial m_adjacencyList and initialize newAdjacencyList
-		for (auto currentNode = m_adjacencyList.begin(); currentNode != m_adjacencyList.end(); currentNode++) {
-			// adjacency list for current currentNeighbors 
-			for (auto neighbor = currentNode->second.begin(); neighbor != currentNode->second.end(); neighbor++) {
-
-				// only if the current node and its current neighbor do not belong to the same component
-				if (!unionFind.connected(currentNode->first, neighbor->first)) {
-					// add if it's not added yet to the new list
-					if ((newAdjacencyList[unionFind.find(currentNode->first)]).find(unionFind.find(neighbor->first)) == (newAdjacencyList[unionFind.find(currentNode->first)]).end()) {
-						newAdjacencyList[unionFind.find(currentNode->first)][unionFind.find(neighbor->first)] = neighbor->second;
-					}
-					// update value if it's added, but with greater weight
-					else if (newAdjacencyList[unionFind.find(currentNode->first)][unionFind.find(neighbor->first)] > neighbor->second) {
-						newAdjacencyList[unionFind.find(currentNode->first)][unionFind.find(neighbor->first)] = neighbor->second;
-					}
-				}
+			else if (weight < m_heap.getKey(neighbor)) {
+				m_heap.decreaseKey(neighbor, weight);
+				m_cheapestEdge[neighbor] = m_edgeIds[position];
 			}
 		}
-
-
-		m_adjacencyList = newAdjacencyList;
-		// solve the same, but contracted problem using recursion
-		findMST(unionFind);
 	}
-	
-	void printResult() {
 
-		for (auto& edge : m_result) {
-			//cout << "(" << get<0>(edge) << ", " << get<1>(edge) << ") weight: " << get<2>(edge) << ")" << endl;
-			m_mstWeight += get<2>(edge);
+	// renames endpoints to the tree ids, removes loops and keeps only the cheapest of the parallel edges
+	void contract(vector<ContractedEdge>& edges, const vector<int>& treeId) {
+		size_t size = 0;
+		for (const auto& edge : edges) {
+			int from = treeId[m_tree[edge.from]];
+			int to = treeId[m_tree[edge.to]];
+			if (from == to) continue;
+
+			edges[size++] = { min(from, to), max(from, to), edge.weight, edge.id };
 		}
-	}
+		edges.resize(size);
 
-	size_t getMSTWeight() { return m_mstWeight; }
+		sort(edges.begin(), edges.end(), [](const ContractedEdge& a, const ContractedEdge& b) {
+			return tie(a.from, a.to, a.weight) < tie(b.from, b.to, b.weight);
+		});
 
-	double getDuration() { return m_duration; }
+		auto last = unique(edges.begin(), edges.end(), [](const ContractedEdge& a, const ContractedEdge& b) {
+			return a.from == b.from && a.to == b.to;
+		});
+		edges.erase(last, edges.end());
+	}
 
 private:
-	// size of the heap that is controlled carefully and different in different recursive calls
-	int m_heapSize{ 0 };
+	// size of the heap that is controlled carefully and different in different passes
+	size_t m_heapSize{ 0 };
 	int m_nodesNumber{ 0 };
 	int m_edgesNumber{ 0 };
 
 	size_t m_mstWeight{ 0 };
 	double m_duration{ 0 };
-
-	unordered_set<int> m_nodes;
-	// for the purpose of this algorithm is better to have this form of adjacency list
-	unordered_map<int, unordered_map<int, int>> m_adjacencyList;
-	// MST
-	vector<tuple<int, int, int>> m_result;
-};
\ No newline at end of file
+	PhaseTimes m_phases{};
+
+	vector<vector<pair<int, int>>>* m_adjacencyList{ nullptr };
+
+	// original edges (u, v, weight)
+	vector<tuple<int, int, int>> m_edges;
+	// edges of the current contracted graph
+	vector<ContractedEdge> m_contractedEdges;
+
+	// CSR of the contracted graph
+	vector<int> m_offsets;
+	vector<int> m_targets;
+	vector<int> m_weights;
+	vector<int> m_edgeIds;
+
+	// tree of each contracted node, -1 if it's not been visited yet in the current pass
+	vector<int> m_tree;
+	// older tree that the tree has been connected to, itself if there is none
+	vector<int> m_treeParent;
+	// edge id of the current heap key for each node
+	vector<int> m_cheapestEdge;
+	Heap m_heap;
+
+	// MST - ids of the edges in m_edges
+	vector<int> m_result;
+};
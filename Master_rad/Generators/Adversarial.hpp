@@ -0,0 +1,168 @@
+#pragma once
+
+#include "ParallelGenerator.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+// worst-case inputs of the engines, used to measure tail latencies instead of the averages on uniform random graphs
+// the structure that makes an engine slow is a spanning path with chosen weights, the other edges are sampled
+// like in make_connected_fixed_density_csr and are heavier than the path unless written otherwise
+
+namespace mstgen {
+
+    // sorted keys of the path 0 - 1 - ... - n-1
+    inline std::vector<std::uint64_t> path_keys(std::size_t n) {
+        std::vector<std::uint64_t> path;
+        for (std::size_t u = 1; u < n; ++u) {
+            path.push_back(pack_edge(u - 1, u));
+        }
+        return path;
+    }
+
+    // rank of each edge (index of its sorted key) in the order of descending sources and ascending targets
+    inline std::vector<std::size_t> descending_source_ranks(std::size_t n, const std::vector<std::uint64_t>& keys, unsigned workersNumber = 0) {
+        // first edge of each source
+        std::vector<std::size_t> rows(n + 1, 0);
+        for (auto key : keys) {
+            rows[edge_source(key) + 1]++;
+        }
+        std::partial_sum(rows.begin(), rows.end(), rows.begin());
+
+        std::vector<std::size_t> ranks(keys.size());
+        const std::size_t chunks = chunks_number(n, workersNumber);
+        runTasks(chunks, [&](std::size_t chunk) {
+            for (std::size_t u = chunk * n / chunks; u < (chunk + 1) * n / chunks; ++u) {
+                for (std::size_t i = rows[u]; i < rows[u + 1]; ++i) {
+                    ranks[i] = (keys.size() - rows[u + 1]) + (i - rows[u]);
+                }
+            }
+        }, workersNumber);
+
+        return ranks;
+    }
+
+    // random order of the nodes
+    inline std::vector<int> random_order(std::size_t n, const CounterRng& rng, unsigned workersNumber = 0) {
+        std::vector<int> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        parallelRadixSort(order, [&](int u) { return rng(static_cast<std::uint64_t>(u)); }, workersNumber);
+        return order;
+    }
+
+    // renames the node u to order[u], the edges are sorted again
+    inline std::vector<PackedEdge> relabel(std::vector<PackedEdge> edges, const std::vector<int>& order, unsigned workersNumber = 0) {
+        const std::size_t chunks = chunks_number(edges.size(), workersNumber);
+        runTasks(chunks, [&](std::size_t chunk) {
+            for (std::size_t i = chunk * edges.size() / chunks; i < (chunk + 1) * edges.size() / chunks; ++i) {
+                edges[i].key = pack_undirected_edge(order[edge_source(edges[i].key)], order[edge_target(edges[i].key)]);
+            }
+        }, workersNumber);
+
+        parallelRadixSort(edges, [](const PackedEdge& edge) { return edge.key; }, workersNumber);
+        return edges;
+    }
+
+    // Prim: the weights fall with the earlier endpoint, (u, v) is lighter than every edge (w, v) with w before u,
+    // so every visited node lowers the keys of all its unvisited neighbors and every edge is a decrease-key
+    // the first edge of the order is the lightest, Prim starts from it and visits the nodes in the order,
+    // which is random so that the visits don't walk the memory sequentially
+    inline CSRGraph make_prim_worst_csr(std::size_t n, double d, std::uint32_t seed = 123, unsigned workersNumber = 0) {
+        if (n == 0) return CSRGraph{};
+
+        const CounterRng orderRng(seed, 6);
+
+        // positions in the order
+        const auto keys = fixed_density_keys(n, d, path_keys(n), seed, workersNumber);
+        const auto ranks = descending_source_ranks(n, keys, workersNumber);
+
+        std::vector<PackedEdge> edges(keys.size());
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            edges[i] = { keys[i], keys[i] == pack_edge(0, 1) ? 1 : 2 + static_cast<int>(ranks[i]) };
+        }
+
+        // Prim starts from the smaller endpoint of the lightest edge
+        auto order = random_order(n, orderRng, workersNumber);
+        if (n > 1 && order[0] > order[1]) std::swap(order[0], order[1]);
+
+        return to_csr(n, relabel(std::move(edges), order, workersNumber));
+    }
+
+    // number of trailing zero bits, 0 for 0
+    inline int trailing_zeros(std::uint64_t x) {
+        int zeros = 0;
+        while (x && !(x & 1)) { x >>= 1; zeros++; }
+        return zeros;
+    }
+
+    // Boruvka: the path edge (u, u+1) weighs by the trailing zeros of u+1 (the ruler sequence), so in every round
+    // each component's lightest edge joins it with just one neighbor: the path only halves and there are log n rounds,
+    // each of them scanning all the other edges
+    inline CSRGraph make_boruvka_worst_csr(std::size_t n, double d, std::uint32_t seed = 123, unsigned workersNumber = 0) {
+        if (n == 0) return CSRGraph{};
+
+        const CounterRng weightRng(seed, 3);
+        const auto keys = fixed_density_keys(n, d, path_keys(n), seed, workersNumber);
+        const int step = static_cast<int>(n);
+
+        return to_csr(n, with_weights(keys, [&](std::uint64_t key) {
+            const int u = edge_source(key), v = edge_target(key);
+            if (v == u + 1) return trailing_zeros(static_cast<std::uint64_t>(v)) * step + v;
+            return 32 * step + 1 + static_cast<int>(weightRng.below(key, 1000));
+        }, workersNumber));
+    }
+
+    // Chazelle: the Boruvka path, so the Boruvka phases don't shrink the graph, with the other edges heavier than the path
+    // and ranked like in make_prim_worst_csr: the heaps of the active path receive heavier edges after lighter ones
+    // from the same nodes, which makes the most soft heap corruptions we have found (about 100 times the uniform weights)
+    inline CSRGraph make_chazelle_worst_csr(std::size_t n, double d, std::uint32_t seed = 123, unsigned workersNumber = 0) {
+        if (n == 0) return CSRGraph{};
+
+        const auto keys = fixed_density_keys(n, d, path_keys(n), seed, workersNumber);
+        const auto ranks = descending_source_ranks(n, keys, workersNumber);
+        const int step = static_cast<int>(n);
+
+        std::vector<PackedEdge> edges(keys.size());
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            const int u = edge_source(keys[i]), v = edge_target(keys[i]);
+            edges[i] = { keys[i], v == u + 1 ? trailing_zeros(static_cast<std::uint64_t>(v)) * step + v : 32 * step + 1 + static_cast<int>(ranks[i]) };
+        }
+        return to_csr(n, edges);
+    }
+
+    // Karger: the Boruvka path (the two Boruvka steps contract only by 4) with n / 2 random heavier edges
+    // the sample of half of the edges is then a forest of many small trees, edges between the trees are always F-light,
+    // so the filtering removes almost nothing and both recursive calls get most of the edges
+    inline CSRGraph make_karger_worst_csr(std::size_t n, std::uint32_t seed = 123, unsigned workersNumber = 0) {
+        const double d = n > 1 ? std::min(1.0, 3.0 / static_cast<double>(n - 1)) : 0.0;
+        return make_boruvka_worst_csr(n, d, seed, workersNumber);
+    }
+
+    // tree path maxima (Karger's verification) and the tree walks of Chazelle: the MST is a Hamiltonian path
+    // through randomly permuted nodes, so the trees are as deep as possible and the queries span long paths
+    inline CSRGraph make_deep_tree_csr(std::size_t n, double d, std::uint32_t seed = 123, unsigned workersNumber = 0) {
+        if (n == 0) return CSRGraph{};
+
+        const CounterRng orderRng(seed, 6), weightRng(seed, 3);
+        const auto order = random_order(n, orderRng, workersNumber);
+
+        std::vector<std::uint64_t> path;
+        for (std::size_t i = 1; i < n; ++i) {
+            path.push_back(pack_undirected_edge(order[i - 1], order[i]));
+        }
+        parallelRadixSort(path, workersNumber);
+
+        const auto keys = fixed_density_keys(n, d, path, seed, workersNumber);
+
+        // path weights are 1 ... 1000, the other edges 1001 ... 2000
+        return to_csr(n, with_weights(keys, [&](std::uint64_t key) {
+            const int weight = 1 + static_cast<int>(weightRng.below(key, 1000));
+            return std::binary_search(path.begin(), path.end(), key) ? weight : 1000 + weight;
+        }, workersNumber));
+    }
+
+} // namespace mstgen
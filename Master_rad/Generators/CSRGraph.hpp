@@ -0,0 +1,197 @@
+#pragma once
+
+#include "../Utils/GraphAccess.h"
+#include "../Utils/TaskPool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+// undirected weighted graph in the compressed sparse row format
+// neighbors of the node u are neighbors[offsets[u]] ... neighbors[offsets[u + 1] - 1], every edge is stored in both directions
+
+namespace mstgen {
+
+    // the same as in GenerateGraph.hpp, the input of the engines
+    using AdjList = std::vector<std::vector<std::pair<int, int>>>;
+
+    struct CSRGraph {
+        std::vector<std::uint64_t> offsets{ 0 };
+        std::vector<int> neighbors{};
+        std::vector<int> weights{};
+        // optional, id of the undirected edge of each neighbor entry (both directions have the same id)
+        std::vector<std::uint32_t> edgeIds{};
+
+        std::size_t nodesNumber() const { return offsets.size() - 1; }
+        // number of undirected edges
+        std::size_t edgesNumber() const { return neighbors.size() / 2; }
+    };
+
+    // CSR arrays owned by someone else, e.g. a CSRGraph or a memory-mapped file
+    struct CSRView {
+        std::span<const std::uint64_t> offsets{};
+        std::span<const int> neighbors{};
+        std::span<const int> weights{};
+        // empty when the graph has no edge ids
+        std::span<const std::uint32_t> edgeIds{};
+
+        std::size_t nodesNumber() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+        std::size_t edgesNumber() const { return neighbors.size() / 2; }
+    };
+
+    inline CSRView view(const CSRGraph& g) {
+        return { g.offsets, g.neighbors, g.weights, g.edgeIds };
+    }
+
+    // edge (u, v) packed as (u << 32) | v, used for sorting and deduplication of the edges
+    struct PackedEdge {
+        std::uint64_t key;
+        int weight;
+    };
+
+    inline std::uint64_t pack_edge(std::uint64_t u, std::uint64_t v) {
+        return (u << 32) | v;
+    }
+
+    // the key of an undirected edge has the smaller endpoint first
+    inline std::uint64_t pack_undirected_edge(std::uint64_t u, std::uint64_t v) {
+        return u < v ? pack_edge(u, v) : pack_edge(v, u);
+    }
+
+    // larger than the key of any edge, marks a missing edge
+    constexpr std::uint64_t no_edge = ~0ull;
+
+    inline int edge_source(std::uint64_t key) { return static_cast<int>(key >> 32); }
+    inline int edge_target(std::uint64_t key) { return static_cast<int>(key & 0xffffffffu); }
+
+    // splits [0, n) into ranges for the workers, a few ranges per worker balance uneven work
+    inline std::size_t chunks_number(std::size_t n, unsigned workersNumber) {
+        const std::size_t workers = workersNumber ? workersNumber : defaultWorkersNumber();
+        return std::max<std::size_t>(1, std::min<std::size_t>(n, 4 * workers));
+    }
+
+    inline double density(const CSRView& g) {
+        const double n = static_cast<double>(g.nodesNumber());
+        const double m = static_cast<double>(g.edgesNumber());
+        return (n <= 1.0) ? 0.0 : (2.0 * m) / (n * (n - 1.0));
+    }
+
+    inline bool is_connected(const CSRView& g) {
+        const std::size_t n = g.nodesNumber();
+        if (n == 0) return true;
+
+        std::vector<char> visited(n, 0);
+        std::vector<int> stack{ 0 };
+        visited[0] = 1;
+        std::size_t reached = 1;
+
+        while (!stack.empty()) {
+            int u = stack.back();
+            stack.pop_back();
+
+            for (auto i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+                int v = g.neighbors[i];
+                if (!visited[v]) {
+                    visited[v] = 1;
+                    reached++;
+                    stack.push_back(v);
+                }
+            }
+        }
+        return reached == n;
+    }
+
+    // builds CSR from distinct undirected edges (keys from pack_undirected_edge) sorted by their keys
+    // edge (u, v) goes to the list of u after the edges (w, u) with w < u, so one pass in the key order
+    // writes every list already sorted, without sorting both directions
+    // the id of an edge is its index in edges
+    inline CSRGraph to_csr(std::size_t n, const std::vector<PackedEdge>& edges, bool withEdgeIds = false) {
+        CSRGraph g;
+        g.offsets.assign(n + 1, 0);
+        g.neighbors.resize(2 * edges.size());
+        g.weights.resize(2 * edges.size());
+        if (withEdgeIds) g.edgeIds.resize(2 * edges.size());
+
+        for (const auto& edge : edges) {
+            g.offsets[edge_source(edge.key) + 1]++;
+            g.offsets[edge_target(edge.key) + 1]++;
+        }
+        for (std::size_t u = 0; u < n; ++u) {
+            g.offsets[u + 1] += g.offsets[u];
+        }
+
+        std::vector<std::uint64_t> next(g.offsets.begin(), g.offsets.end() - 1);
+        for (std::size_t i = 0; i < edges.size(); ++i) {
+            const int u = edge_source(edges[i].key), v = edge_target(edges[i].key);
+            if (withEdgeIds) {
+                g.edgeIds[next[u]] = static_cast<std::uint32_t>(i);
+                g.edgeIds[next[v]] = static_cast<std::uint32_t>(i);
+            }
+            g.neighbors[next[u]] = v;
+            g.weights[next[u]++] = edges[i].weight;
+            g.neighbors[next[v]] = u;
+            g.weights[next[v]++] = edges[i].weight;
+        }
+
+        return g;
+    }
+
+    inline AdjList to_adjacency_list(const CSRView& g, unsigned workersNumber = 0) {
+        const std::size_t n = g.nodesNumber();
+        AdjList adj(n);
+
+        const std::size_t chunks = chunks_number(n, workersNumber);
+        runTasks(chunks, [&](std::size_t chunk) {
+            for (std::size_t u = chunk * n / chunks; u < (chunk + 1) * n / chunks; ++u) {
+                adj[u].reserve(g.offsets[u + 1] - g.offsets[u]);
+                for (auto i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+                    adj[u].push_back({ g.neighbors[i], g.weights[i] });
+                }
+            }
+        }, workersNumber);
+
+        return adj;
+    }
+
+    // CSR with the lists in the order of the adjacency list, so the edges are numbered the same way in both
+    inline CSRGraph to_csr(const AdjList& adj) {
+        CSRGraph g;
+        g.offsets.resize(adj.size() + 1);
+        for (std::size_t u = 0; u < adj.size(); ++u) {
+            g.offsets[u + 1] = g.offsets[u] + adj[u].size();
+        }
+
+        g.neighbors.reserve(g.offsets.back());
+        g.weights.reserve(g.offsets.back());
+        for (const auto& list : adj) {
+            for (const auto& [v, weight] : list) {
+                g.neighbors.push_back(v);
+                g.weights.push_back(weight);
+            }
+        }
+        return g;
+    }
+
+    inline double density(const CSRGraph& g) { return density(view(g)); }
+    inline bool is_connected(const CSRGraph& g) { return is_connected(view(g)); }
+    inline AdjList to_adjacency_list(const CSRGraph& g, unsigned workersNumber = 0) { return to_adjacency_list(view(g), workersNumber); }
+
+} // namespace mstgen
+
+// Prim and Boruvka read the CSR arrays in place, e.g. of a memory-mapped .mstg file
+template<>
+struct GraphAccess<mstgen::CSRView>
+{
+    static size_t nodesNumber(const mstgen::CSRView& graph) { return graph.nodesNumber(); }
+
+    template<typename Visit>
+    static void forEachNeighbor(const mstgen::CSRView& graph, size_t node, Visit visit)
+    {
+        for (auto i = graph.offsets[node]; i < graph.offsets[node + 1]; ++i) {
+            visit(graph.neighbors[i], graph.weights[i]);
+        }
+    }
+};
@@ -0,0 +1,189 @@
+#pragma once
+
+#include "CSRGraph.hpp"
+#include "../Utils/GraphAccess.h"
+#include "../Utils/TaskPool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// compressed CSR for graphs that don't fit into memory as plain CSR (8 bytes per entry + 8 per node)
+// each neighbor list is sorted and stored as byte-aligned varints (7 bits per byte, the high bit means "more"):
+// the first neighbor as the zigzag difference from the node, the others as the gap from the previous neighbor,
+// each followed by the zigzag weight
+// with weights up to 1000 an entry takes 2-5 bytes instead of 8, the lists are decoded in blocks,
+// so the decoding loop and the loop of the caller don't interleave
+
+namespace mstgen {
+
+    namespace detail {
+
+        inline std::uint32_t zigzag(std::int64_t value) {
+            return static_cast<std::uint32_t>((value << 1) ^ (value >> 63));
+        }
+
+        inline std::int64_t unzigzag(std::uint32_t value) {
+            return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+        }
+
+        inline std::size_t varint_size(std::uint32_t value) {
+            std::size_t size = 1;
+            while (value >= 0x80) { value >>= 7; size++; }
+            return size;
+        }
+
+        inline std::uint8_t* write_varint(std::uint8_t* p, std::uint32_t value) {
+            while (value >= 0x80) {
+                *p++ = static_cast<std::uint8_t>(value | 0x80);
+                value >>= 7;
+            }
+            *p++ = static_cast<std::uint8_t>(value);
+            return p;
+        }
+
+        inline const std::uint8_t* read_varint(const std::uint8_t* p, std::uint32_t& value) {
+            // one byte is the common case
+            value = *p++;
+            if (value < 0x80) return p;
+
+            value &= 0x7F;
+            for (int shift = 7;; shift += 7) {
+                const std::uint32_t byte = *p++;
+                value |= (byte & 0x7F) << shift;
+                if (byte < 0x80) return p;
+            }
+        }
+
+    } // namespace detail
+
+    class CompressedCSR {
+    public:
+        // entries decoded at once
+        static constexpr std::size_t block_size = 64;
+
+        CompressedCSR() = default;
+
+        std::size_t nodesNumber() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+
+        // memory of the encoded lists and their offsets
+        std::size_t bytesNumber() const { return bytes.size() + offsets.size() * sizeof(std::uint64_t); }
+
+        // visit(neighbor, weight) for each neighbor of u in increasing order
+        template<typename Visit>
+        void forEachNeighbor(std::size_t u, Visit visit) const {
+            const std::uint8_t* p = bytes.data() + offsets[u];
+            const std::uint8_t* end = bytes.data() + offsets[u + 1];
+
+            int neighbors[block_size];
+            int weights[block_size];
+            std::int64_t previous = static_cast<std::int64_t>(u);
+            bool first = true;
+
+            while (p < end) {
+                std::size_t decoded = 0;
+                for (; decoded < block_size && p < end; ++decoded) {
+                    std::uint32_t gap = 0, weight = 0;
+                    p = detail::read_varint(p, gap);
+                    p = detail::read_varint(p, weight);
+
+                    previous = first ? previous + detail::unzigzag(gap) : previous + gap;
+                    first = false;
+                    neighbors[decoded] = static_cast<int>(previous);
+                    weights[decoded] = static_cast<int>(detail::unzigzag(weight));
+                }
+                for (std::size_t i = 0; i < decoded; ++i) {
+                    visit(neighbors[i], weights[i]);
+                }
+            }
+        }
+
+        // offsets[u] is the first byte of the list of u, offsets[n] the size of bytes
+        std::vector<std::uint64_t> offsets{ 0 };
+        std::vector<std::uint8_t> bytes{};
+    };
+
+    namespace detail {
+
+        // rowOf(u, row) fills the (neighbor, weight) pairs of u, the lists are encoded in parallel in two passes:
+        // the sizes of the lists and then the lists at their offsets
+        template<typename RowOf>
+        CompressedCSR compress_rows(std::size_t n, RowOf rowOf, unsigned workersNumber) {
+            CompressedCSR g;
+            g.offsets.assign(n + 1, 0);
+
+            auto encodedSize = [](std::size_t u, const std::vector<std::pair<int, int>>& row) {
+                std::size_t size = 0;
+                std::int64_t previous = static_cast<std::int64_t>(u);
+                for (std::size_t i = 0; i < row.size(); ++i) {
+                    size += varint_size(i == 0 ? zigzag(row[i].first - previous) : static_cast<std::uint32_t>(row[i].first - previous));
+                    size += varint_size(zigzag(row[i].second));
+                    previous = row[i].first;
+                }
+                return size;
+            };
+
+            const std::size_t chunks = chunks_number(n, workersNumber);
+            runTasks(chunks, [&](std::size_t chunk) {
+                std::vector<std::pair<int, int>> row;
+                for (std::size_t u = chunk * n / chunks; u < (chunk + 1) * n / chunks; ++u) {
+                    rowOf(u, row);
+                    g.offsets[u + 1] = encodedSize(u, row);
+                }
+            }, workersNumber);
+
+            for (std::size_t u = 0; u < n; ++u) {
+                g.offsets[u + 1] += g.offsets[u];
+            }
+            g.bytes.resize(g.offsets[n]);
+
+            runTasks(chunks, [&](std::size_t chunk) {
+                std::vector<std::pair<int, int>> row;
+                for (std::size_t u = chunk * n / chunks; u < (chunk + 1) * n / chunks; ++u) {
+                    rowOf(u, row);
+                    std::uint8_t* p = g.bytes.data() + g.offsets[u];
+                    std::int64_t previous = static_cast<std::int64_t>(u);
+                    for (std::size_t i = 0; i < row.size(); ++i) {
+                        p = write_varint(p, i == 0 ? zigzag(row[i].first - previous) : static_cast<std::uint32_t>(row[i].first - previous));
+                        p = write_varint(p, zigzag(row[i].second));
+                        previous = row[i].first;
+                    }
+                }
+            }, workersNumber);
+
+            return g;
+        }
+
+    } // namespace detail
+
+    // CSR lists are already sorted
+    inline CompressedCSR compress(const CSRView& g, unsigned workersNumber = 0) {
+        return detail::compress_rows(g.nodesNumber(), [&](std::size_t u, std::vector<std::pair<int, int>>& row) {
+            row.clear();
+            for (std::uint64_t i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+                row.push_back({ g.neighbors[i], g.weights[i] });
+            }
+        }, workersNumber);
+    }
+
+    // the lists of an adjacency list are sorted by the neighbors first
+    inline CompressedCSR compress(const AdjList& adjacencyList, unsigned workersNumber = 0) {
+        return detail::compress_rows(adjacencyList.size(), [&](std::size_t u, std::vector<std::pair<int, int>>& row) {
+            row.assign(adjacencyList[u].begin(), adjacencyList[u].end());
+            std::sort(row.begin(), row.end());
+        }, workersNumber);
+    }
+
+} // namespace mstgen
+
+// Prim and Boruvka iterate the compressed lists directly
+template<>
+struct GraphAccess<mstgen::CompressedCSR>
+{
+    static size_t nodesNumber(const mstgen::CompressedCSR& graph) { return graph.nodesNumber(); }
+
+    template<typename Visit>
+    static void forEachNeighbor(const mstgen::CompressedCSR& graph, size_t node, Visit visit) { graph.forEachNeighbor(node, visit); }
+};
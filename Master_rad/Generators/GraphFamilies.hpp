@@ -0,0 +1,291 @@
+#pragma once
+
+#include "Adversarial.hpp"
+#include "ParallelGenerator.hpp"
+#include "../Utils/UnionFind.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+// graph families with structure, unlike the uniform random graphs of make_connected_fixed_density_csr:
+// grids (road meshes), random geometric graphs, R-MAT and Barabasi-Albert (heavy-tailed degrees)
+// every generator returns a connected graph and depends only on the seed, not on the number of workers
+
+namespace mstgen {
+
+    enum class GraphFamily {
+        Random, Grid2D, Grid3D, Geometric, RMat, BarabasiAlbert,
+        // worst cases of the engines from Adversarial.hpp
+        PrimWorst, BoruvkaWorst, KargerWorst, ChazelleWorst, DeepTree
+    };
+
+    inline const std::vector<GraphFamily>& graph_families() {
+        static const std::vector<GraphFamily> families{
+            GraphFamily::Random, GraphFamily::Grid2D, GraphFamily::Grid3D, GraphFamily::Geometric, GraphFamily::RMat,
+            GraphFamily::BarabasiAlbert, GraphFamily::PrimWorst, GraphFamily::BoruvkaWorst, GraphFamily::KargerWorst,
+            GraphFamily::ChazelleWorst, GraphFamily::DeepTree };
+        return families;
+    }
+
+    inline bool is_adversarial(GraphFamily family) {
+        return family >= GraphFamily::PrimWorst;
+    }
+
+    inline const char* graph_family_name(GraphFamily family) {
+        switch (family) {
+        case GraphFamily::Grid2D: return "grid2d";
+        case GraphFamily::Grid3D: return "grid3d";
+        case GraphFamily::Geometric: return "geometric";
+        case GraphFamily::RMat: return "rmat";
+        case GraphFamily::BarabasiAlbert: return "ba";
+        case GraphFamily::PrimWorst: return "prim-worst";
+        case GraphFamily::BoruvkaWorst: return "boruvka-worst";
+        case GraphFamily::KargerWorst: return "karger-worst";
+        case GraphFamily::ChazelleWorst: return "chazelle-worst";
+        case GraphFamily::DeepTree: return "deep-tree";
+        default: return "random";
+        }
+    }
+
+    // links the components into a path: the smallest node of each component is connected to the smallest node of the previous one
+    // returns the sorted keys together with the new edges
+    inline std::vector<std::uint64_t> connect_components(std::size_t n, const std::vector<std::uint64_t>& keys) {
+        UnionFind components(static_cast<int>(n));
+        for (auto key : keys) {
+            components.unionOperation(edge_source(key), edge_target(key));
+        }
+
+        // the sources grow, so the links are sorted
+        std::vector<std::uint64_t> links;
+        int last = 0;
+        for (int u = 1; u < static_cast<int>(n); ++u) {
+            if (components.connected(0, u)) continue;
+            links.push_back(pack_edge(last, u));
+            components.unionOperation(0, u);
+            last = u;
+        }
+
+        std::vector<std::uint64_t> connected;
+        connected.reserve(keys.size() + links.size());
+        std::merge(keys.begin(), keys.end(), links.begin(), links.end(), std::back_inserter(connected));
+        return connected;
+    }
+
+    // smallest s with s^dimensions >= n
+    inline std::size_t grid_side(std::size_t n, int dimensions) {
+        std::size_t side = static_cast<std::size_t>(std::pow(static_cast<double>(n), 1.0 / dimensions));
+        auto volume = [&](std::size_t s) { std::size_t v = 1; for (int i = 0; i < dimensions; ++i) v *= s; return v; };
+        while (side > 1 && volume(side - 1) >= n) side--;
+        while (volume(side) < n) side++;
+        return side;
+    }
+
+    // 2D or 3D grid with random weights, the nodes are numbered row by row and the last row (layer) may be incomplete
+    // each node is connected to its predecessor in every dimension, so the grid stays connected
+    inline CSRGraph make_grid_csr(std::size_t n, int dimensions, std::uint32_t seed = 123,
+        WeightDistribution weights = WeightDistribution::Uniform, unsigned workersNumber = 0) {
+
+        if (dimensions != 2 && dimensions != 3) throw std::runtime_error("grid must have 2 or 3 dimensions");
+        if (n == 0) return CSRGraph{};
+
+        const std::size_t side = grid_side(n, dimensions);
+        const CounterRng weightRng(seed, 3);
+
+        // dimensions slots per node, missing neighbors are no_edge
+        std::vector<std::uint64_t> keys(n * dimensions, no_edge);
+        const std::size_t chunks = chunks_number(n, workersNumber);
+        runTasks(chunks, [&](std::size_t chunk) {
+            for (std::size_t u = chunk * n / chunks; u < (chunk + 1) * n / chunks; ++u) {
+                std::size_t stride = 1, rest = u;
+                for (int k = 0; k < dimensions; ++k) {
+                    if (rest % side) keys[u * dimensions + k] = pack_edge(u - stride, u);
+                    rest /= side;
+                    stride *= side;
+                }
+            }
+        }, workersNumber);
+
+        parallelRadixSort(keys, workersNumber);
+        keys.erase(std::lower_bound(keys.begin(), keys.end(), no_edge), keys.end());
+
+        return to_csr(n, with_random_weights(keys, weightRng, weights, workersNumber));
+    }
+
+    // n random points in the unit square, two points closer than r are connected with the weight 1 + round(999 * distance / r)
+    // r is chosen for the average degree (ignoring the border), the points are bucketed into cells of size at least r
+    // components are linked by connect_components with the same Euclidean weights
+    inline CSRGraph make_random_geometric_csr(std::size_t n, double averageDegree, std::uint32_t seed = 123, unsigned workersNumber = 0) {
+        if (n == 0) return CSRGraph{};
+
+        const double pi = 3.14159265358979323846;
+        const double r = n > 1 ? std::min(std::sqrt(2.0), std::sqrt(std::max(averageDegree, 0.0) / (pi * static_cast<double>(n - 1)))) : 1.0;
+        const CounterRng pointRng(seed, 4);
+
+        std::vector<double> x(n), y(n);
+        const std::size_t pointChunks = chunks_number(n, workersNumber);
+        runTasks(pointChunks, [&](std::size_t chunk) {
+            for (std::size_t u = chunk * n / pointChunks; u < (chunk + 1) * n / pointChunks; ++u) {
+                x[u] = pointRng.uniform(2 * u);
+                y[u] = pointRng.uniform(2 * u + 1);
+            }
+        }, workersNumber);
+
+        // cells * cells buckets, at most about n of them
+        const std::size_t cells = std::max<std::size_t>(1, std::min(static_cast<std::size_t>(1.0 / std::max(r, 1e-9)),
+            static_cast<std::size_t>(std::sqrt(static_cast<double>(n))) + 1));
+        auto cellOf = [&](double coordinate) { return std::min(cells - 1, static_cast<std::size_t>(coordinate * static_cast<double>(cells))); };
+
+        std::vector<std::size_t> cellBegin(cells * cells + 1, 0);
+        for (std::size_t u = 0; u < n; ++u) {
+            cellBegin[cellOf(y[u]) * cells + cellOf(x[u]) + 1]++;
+        }
+        for (std::size_t c = 0; c < cells * cells; ++c) {
+            cellBegin[c + 1] += cellBegin[c];
+        }
+        std::vector<int> cellNodes(n);
+        std::vector<std::size_t> next(cellBegin.begin(), cellBegin.end() - 1);
+        for (std::size_t u = 0; u < n; ++u) {
+            cellNodes[next[cellOf(y[u]) * cells + cellOf(x[u])]++] = static_cast<int>(u);
+        }
+
+        auto distance = [&](std::size_t u, std::size_t v) { return std::hypot(x[u] - x[v], y[u] - y[v]); };
+
+        // each pair is found from its smaller node, the chunks are concatenated in order
+        std::vector<std::vector<std::uint64_t>> found(pointChunks);
+        runTasks(pointChunks, [&](std::size_t chunk) {
+            for (std::size_t u = chunk * n / pointChunks; u < (chunk + 1) * n / pointChunks; ++u) {
+                const std::size_t cx = cellOf(x[u]), cy = cellOf(y[u]);
+                for (std::size_t ny = cy ? cy - 1 : 0; ny <= std::min(cells - 1, cy + 1); ++ny) {
+                    for (std::size_t nx = cx ? cx - 1 : 0; nx <= std::min(cells - 1, cx + 1); ++nx) {
+                        for (std::size_t i = cellBegin[ny * cells + nx]; i < cellBegin[ny * cells + nx + 1]; ++i) {
+                            const std::size_t v = static_cast<std::size_t>(cellNodes[i]);
+                            if (v > u && distance(u, v) <= r) found[chunk].push_back(pack_edge(u, v));
+                        }
+                    }
+                }
+            }
+        }, workersNumber);
+
+        std::vector<std::uint64_t> keys;
+        for (const auto& part : found) {
+            keys.insert(keys.end(), part.begin(), part.end());
+        }
+        found.clear();
+        parallelRadixSort(keys, workersNumber);
+        keys = connect_components(n, keys);
+
+        return to_csr(n, with_weights(keys, [&](std::uint64_t key) {
+            return 1 + static_cast<int>(std::llround(999.0 * distance(edge_source(key), edge_target(key)) / r));
+        }, workersNumber));
+    }
+
+    // R-MAT with the Graph500 probabilities (0.57, 0.19, 0.19, 0.05): every edge picks a quadrant of the adjacency matrix
+    // on each level, which gives power-law degrees with the hubs at small ids
+    // draws outside [0, n) and loops are rejected, isolated nodes are linked by connect_components
+    // a very skewed matrix may not have m distinct pairs within 64 * m draws, then the graph has fewer edges
+    inline CSRGraph make_rmat_csr(std::size_t n, std::size_t m, std::uint32_t seed = 123,
+        WeightDistribution weights = WeightDistribution::Uniform, unsigned workersNumber = 0) {
+
+        if (n == 0) return CSRGraph{};
+
+        const std::size_t maxM = n * (n - 1) / 2;
+        m = std::min(m, maxM);
+
+        int levels = 0;
+        while ((std::size_t{ 1 } << levels) < n) levels++;
+
+        const CounterRng pairRng(seed, 1), priorityRng(seed, 2), weightRng(seed, 3);
+        const double a = 0.57, b = 0.19, c = 0.19;
+
+        const std::vector<std::uint64_t> none;
+        auto keys = sample_distinct_pairs(maxM, none, m, [&](std::uint64_t counter) {
+            std::uint64_t u = 0, v = 0;
+            for (int level = 0; level < levels; ++level) {
+                const double p = pairRng.uniform(counter * 64 + level);
+                u <<= 1;
+                v <<= 1;
+                if (p >= a + b + c) { u |= 1; v |= 1; }
+                else if (p >= a + b) u |= 1;
+                else if (p >= a) v |= 1;
+            }
+            return u >= n || v >= n || u == v ? no_edge : pack_undirected_edge(u, v);
+        }, priorityRng, workersNumber, 64 * static_cast<std::uint64_t>(m) + 1024);
+
+        keys = connect_components(n, keys);
+        return to_csr(n, with_random_weights(keys, weightRng, weights, workersNumber));
+    }
+
+    // Barabasi-Albert preferential attachment: nodes 0 ... k form a clique, every next node is connected to k distinct
+    // older nodes, each chosen with the probability proportional to its degree
+    // the process is serial, but the draws are counter-based like everywhere else
+    inline CSRGraph make_barabasi_albert_csr(std::size_t n, std::size_t k, std::uint32_t seed = 123,
+        WeightDistribution weights = WeightDistribution::Uniform, unsigned workersNumber = 0) {
+
+        if (n == 0) return CSRGraph{};
+        k = std::max<std::size_t>(1, std::min(k, n - 1));
+
+        const CounterRng attachRng(seed, 5), weightRng(seed, 3);
+
+        std::vector<std::uint64_t> keys;
+        // every edge adds both of its endpoints, so a uniform element is a node chosen proportionally to the degree
+        std::vector<int> endpoints;
+        for (std::size_t u = 0; u <= k && u < n; ++u) {
+            for (std::size_t v = u + 1; v <= k && v < n; ++v) {
+                keys.push_back(pack_edge(u, v));
+                endpoints.push_back(static_cast<int>(u));
+                endpoints.push_back(static_cast<int>(v));
+            }
+        }
+
+        std::uint64_t counter = 0;
+        std::vector<std::size_t> chosenBy(n, n);
+        std::vector<int> targets;
+        for (std::size_t v = k + 1; v < n; ++v) {
+            targets.clear();
+            while (targets.size() < k) {
+                const int u = endpoints[attachRng.below(counter++, endpoints.size())];
+                if (chosenBy[u] == v) continue;
+                chosenBy[u] = v;
+                targets.push_back(u);
+            }
+            for (int u : targets) {
+                keys.push_back(pack_edge(u, v));
+                endpoints.push_back(u);
+                endpoints.push_back(static_cast<int>(v));
+            }
+        }
+
+        parallelRadixSort(keys, workersNumber);
+        return to_csr(n, with_random_weights(keys, weightRng, weights, workersNumber));
+    }
+
+    // graph of the family with about d * n(n-1)/2 edges, the density is translated into the parameter of the family
+    // grids and karger-worst have a fixed degree and ignore d, the weights of the adversarial families are fixed by their structure
+    inline CSRGraph make_family_csr(GraphFamily family, std::size_t n, double d, std::uint32_t seed = 123,
+        WeightDistribution weights = WeightDistribution::Uniform, unsigned workersNumber = 0) {
+
+        const double averageDegree = n > 1 ? d * static_cast<double>(n - 1) : 0.0;
+        const std::size_t m = static_cast<std::size_t>(std::llround(averageDegree * static_cast<double>(n) / 2.0));
+
+        switch (family) {
+        case GraphFamily::Grid2D: return make_grid_csr(n, 2, seed, weights, workersNumber);
+        case GraphFamily::Grid3D: return make_grid_csr(n, 3, seed, weights, workersNumber);
+        case GraphFamily::Geometric: return make_random_geometric_csr(n, averageDegree, seed, workersNumber);
+        case GraphFamily::RMat: return make_rmat_csr(n, m, seed, weights, workersNumber);
+        case GraphFamily::BarabasiAlbert:
+            return make_barabasi_albert_csr(n, static_cast<std::size_t>(std::llround(averageDegree / 2.0)), seed, weights, workersNumber);
+        case GraphFamily::PrimWorst: return make_prim_worst_csr(n, d, seed, workersNumber);
+        case GraphFamily::BoruvkaWorst: return make_boruvka_worst_csr(n, d, seed, workersNumber);
+        case GraphFamily::KargerWorst: return make_karger_worst_csr(n, seed, workersNumber);
+        case GraphFamily::ChazelleWorst: return make_chazelle_worst_csr(n, d, seed, workersNumber);
+        case GraphFamily::DeepTree: return make_deep_tree_csr(n, d, seed, workersNumber);
+        default: return make_connected_fixed_density_csr(n, d, seed, weights, workersNumber);
+        }
+    }
+
+} // namespace mstgen
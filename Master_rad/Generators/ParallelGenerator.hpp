@@ -0,0 +1,238 @@
+#pragma once
+
+#include "CSRGraph.hpp"
+#include "Weights.hpp"
+#include "../Utils/ParallelSort.h"
+#include "../Utils/TaskPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+// parallel version of make_connected_fixed_density_graph that writes CSR directly, without BGL and hash sets
+
+namespace mstgen {
+
+    // counter-based random numbers: the i-th number of a stream depends only on (seed, stream, i),
+    // so the threads don't share a generator and the graph doesn't depend on the number of threads
+    class CounterRng {
+    public:
+        CounterRng(std::uint64_t seed, std::uint64_t stream)
+            : m_key(mix(seed * 0xD1B54A32D192ED03ull + stream + 1)) {}
+
+        std::uint64_t operator()(std::uint64_t counter) const {
+            return mix(m_key + counter * 0x9E3779B97F4A7C15ull);
+        }
+
+        // uniform in [0, bound), the modulo bias is negligible for the bounds used here
+        std::uint64_t below(std::uint64_t counter, std::uint64_t bound) const {
+            return (*this)(counter) % bound;
+        }
+
+        // uniform in [0, 1)
+        double uniform(std::uint64_t counter) const {
+            return static_cast<double>((*this)(counter) >> 11) * 0x1.0p-53;
+        }
+
+    private:
+        // splitmix64 finalizer
+        static std::uint64_t mix(std::uint64_t x) {
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+            return x ^ (x >> 31);
+        }
+
+        std::uint64_t m_key;
+    };
+
+    // random recursive tree: node i is connected to a random node j < i, the keys are sorted
+    inline std::vector<std::uint64_t> random_tree_keys(std::size_t n, const CounterRng& rng, unsigned workersNumber = 0) {
+        std::vector<std::uint64_t> tree(n > 1 ? n - 1 : 0);
+
+        const std::size_t chunks = chunks_number(tree.size(), workersNumber);
+        runTasks(chunks, [&](std::size_t chunk) {
+            for (std::size_t i = chunk * tree.size() / chunks + 1; i <= (chunk + 1) * tree.size() / chunks; ++i) {
+                tree[i - 1] = pack_undirected_edge(rng.below(i, i), i);
+            }
+        }, workersNumber);
+
+        parallelRadixSort(tree, workersNumber);
+        return tree;
+    }
+
+    // attaches weightOf(key) to each key, in parallel
+    template<typename WeightOf>
+    std::vector<PackedEdge> with_weights(const std::vector<std::uint64_t>& keys, WeightOf weightOf, unsigned workersNumber = 0) {
+        std::vector<PackedEdge> edges(keys.size());
+
+        const std::size_t chunks = chunks_number(keys.size(), workersNumber);
+        runTasks(chunks, [&](std::size_t chunk) {
+            for (std::size_t i = chunk * keys.size() / chunks; i < (chunk + 1) * keys.size() / chunks; ++i) {
+                edges[i] = { keys[i], weightOf(keys[i]) };
+            }
+        }, workersNumber);
+
+        return edges;
+    }
+
+    // random weights from the distribution, the weight depends on the edge, not on its position
+    inline std::vector<PackedEdge> with_random_weights(const std::vector<std::uint64_t>& keys, const CounterRng& rng,
+        WeightDistribution distribution = WeightDistribution::Uniform, unsigned workersNumber = 0) {
+
+        return with_weights(keys, [&](std::uint64_t key) { return weight_from(rng(key), distribution); }, workersNumber);
+    }
+
+    // count distinct sorted keys drawn by pairOf(counter) that are not in the tree (sorted keys)
+    // pairOf returns no_edge for a rejected draw, e.g. a loop
+    // candidates are drawn in batches and deduplicated by sorting, the surplus is dropped by a random priority
+    // the expected cost is O(count) while at most half of the pairs outside of the tree are taken
+    // sampling stops after maxDraws draws, possibly with fewer pairs, for distributions that can't give count distinct pairs
+    template<typename PairOf>
+    std::vector<std::uint64_t> sample_distinct_pairs(std::size_t maxM, const std::vector<std::uint64_t>& tree, std::size_t count,
+        PairOf pairOf, const CounterRng& priorityRng, unsigned workersNumber = 0,
+        std::uint64_t maxDraws = std::numeric_limits<std::uint64_t>::max()) {
+
+        std::vector<std::uint64_t> extra;
+        std::vector<std::uint64_t> candidates, merged;
+        std::uint64_t counter = 0;
+
+        while (extra.size() < count && counter < maxDraws) {
+            // part of the pairs that are still free, more candidates are drawn when the graph is dense
+            const double free = 1.0 - static_cast<double>(tree.size() + extra.size()) / static_cast<double>(maxM);
+            const std::size_t need = count - extra.size();
+            const std::size_t batch = static_cast<std::size_t>(static_cast<double>(need) / std::max(free, 0.01) * 1.1) + 64;
+
+            candidates.resize(batch);
+            const std::size_t chunks = chunks_number(batch, workersNumber);
+            runTasks(chunks, [&](std::size_t chunk) {
+                for (std::size_t i = chunk * batch / chunks; i < (chunk + 1) * batch / chunks; ++i) {
+                    candidates[i] = pairOf(counter + i);
+                }
+            }, workersNumber);
+            counter += batch;
+
+            // dedup by sorting, rejected draws end up at the back
+            parallelRadixSort(candidates, workersNumber);
+            candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+            if (!candidates.empty() && candidates.back() == no_edge) candidates.pop_back();
+
+            merged.clear();
+            std::set_difference(candidates.begin(), candidates.end(), tree.begin(), tree.end(), std::back_inserter(merged));
+            candidates.swap(merged);
+
+            merged.clear();
+            std::set_union(extra.begin(), extra.end(), candidates.begin(), candidates.end(), std::back_inserter(merged));
+            extra.swap(merged);
+        }
+
+        // too many pairs have been sampled: the ones with the smallest random priorities are kept
+        if (extra.size() > count) {
+            std::nth_element(extra.begin(), extra.begin() + count, extra.end(), [&](std::uint64_t a, std::uint64_t b) {
+                return priorityRng(a) < priorityRng(b);
+            });
+            extra.resize(count);
+            parallelRadixSort(extra, workersNumber);
+        }
+
+        return extra;
+    }
+
+    // uniformly random pairs of distinct nodes, see sample_distinct_pairs
+    inline std::vector<std::uint64_t> sample_pairs(std::size_t n, const std::vector<std::uint64_t>& tree, std::size_t count,
+        const CounterRng& pairRng, const CounterRng& priorityRng, unsigned workersNumber = 0) {
+
+        return sample_distinct_pairs(n * (n - 1) / 2, tree, count, [&](std::uint64_t c) {
+            const std::uint64_t u = pairRng.below(2 * c, n), v = pairRng.below(2 * c + 1, n);
+            return u == v ? no_edge : pack_undirected_edge(u, v);
+        }, priorityRng, workersNumber);
+    }
+
+    // all pairs (u, v), u < v, that are in neither of the sorted key lists, in the key order
+    // the rows of the upper triangle are written in parallel, each chunk gets about the same number of pairs
+    inline std::vector<std::uint64_t> complement_pairs(std::size_t n, const std::vector<std::uint64_t>& tree,
+        const std::vector<std::uint64_t>& excluded, unsigned workersNumber = 0) {
+
+        auto rowBegin = [](const std::vector<std::uint64_t>& keys, std::size_t u) {
+            return static_cast<std::size_t>(std::lower_bound(keys.begin(), keys.end(), pack_edge(u, 0)) - keys.begin());
+        };
+
+        // first position of each row in the result
+        std::vector<std::size_t> rows(n + 1, 0);
+        for (std::size_t u = 0; u < n; ++u) {
+            const std::size_t taken = (rowBegin(tree, u + 1) - rowBegin(tree, u)) + (rowBegin(excluded, u + 1) - rowBegin(excluded, u));
+            rows[u + 1] = rows[u] + (n - 1 - u) - taken;
+        }
+
+        std::vector<std::uint64_t> keys(rows[n]);
+
+        const std::size_t chunks = chunks_number(keys.size(), workersNumber);
+        runTasks(chunks, [&](std::size_t chunk) {
+            // rows whose first pair falls into the chunk's part of the result
+            const std::size_t first = std::lower_bound(rows.begin(), rows.end() - 1, chunk * keys.size() / chunks) - rows.begin();
+            const std::size_t last = chunk + 1 == chunks ? n
+                : std::lower_bound(rows.begin(), rows.end() - 1, (chunk + 1) * keys.size() / chunks) - rows.begin();
+
+            std::size_t t = rowBegin(tree, first), e = rowBegin(excluded, first);
+            for (std::size_t u = first; u < last; ++u) {
+                std::size_t position = rows[u];
+                for (std::size_t v = u + 1; v < n; ++v) {
+                    const std::uint64_t key = pack_edge(u, v);
+                    if (t < tree.size() && tree[t] == key) { t++; continue; }
+                    if (e < excluded.size() && excluded[e] == key) { e++; continue; }
+                    keys[position++] = key;
+                }
+            }
+        }, workersNumber);
+
+        return keys;
+    }
+
+    // sorted keys of round(d * n(n-1)/2) edges (at least the tree): the spanning tree (sorted keys) plus uniformly sampled pairs
+    // when more than half of the pairs outside of the tree are needed, the pairs that are left out are sampled instead
+    // and the upper triangle is enumerated without them, so the cost stays O(n + m) up to d = 1
+    inline std::vector<std::uint64_t> fixed_density_keys(std::size_t n, double d, const std::vector<std::uint64_t>& tree,
+        std::uint32_t seed, unsigned workersNumber = 0) {
+
+        if (!(0.0 <= d && d <= 1.0)) throw std::runtime_error("density d not in [0,1]");
+        if (n > static_cast<std::size_t>(std::numeric_limits<int>::max())) throw std::runtime_error("too many nodes");
+        if (n == 0) return {};
+
+        const std::size_t maxM = n * (n - 1) / 2;
+        std::size_t m_target = static_cast<std::size_t>(std::llround(d * static_cast<long double>(maxM)));
+        if (m_target < tree.size()) m_target = tree.size();
+        if (m_target > maxM)  m_target = maxM;
+
+        const CounterRng pairRng(seed, 1), priorityRng(seed, 2);
+
+        const std::size_t extraTarget = m_target - tree.size();
+        const std::size_t freePairs = maxM - tree.size();
+
+        const auto extra = 2 * extraTarget <= freePairs
+            ? sample_pairs(n, tree, extraTarget, pairRng, priorityRng, workersNumber)
+            : complement_pairs(n, tree, sample_pairs(n, tree, freePairs - extraTarget, pairRng, priorityRng, workersNumber), workersNumber);
+
+        std::vector<std::uint64_t> keys;
+        keys.reserve(m_target);
+        std::merge(tree.begin(), tree.end(), extra.begin(), extra.end(), std::back_inserter(keys));
+        return keys;
+    }
+
+    // connected graph with round(d * n(n-1)/2) edges (at least n - 1): a random recursive tree plus uniformly sampled pairs
+    inline CSRGraph make_connected_fixed_density_csr(std::size_t n, double d, std::uint32_t seed = 123,
+        WeightDistribution weights = WeightDistribution::Uniform, unsigned workersNumber = 0) {
+
+        if (n == 0) return CSRGraph{};
+        if (n > static_cast<std::size_t>(std::numeric_limits<int>::max())) throw std::runtime_error("too many nodes");
+
+        const CounterRng treeRng(seed, 0), weightRng(seed, 3);
+        const auto keys = fixed_density_keys(n, d, random_tree_keys(n, treeRng, workersNumber), seed, workersNumber);
+
+        return to_csr(n, with_random_weights(keys, weightRng, weights, workersNumber));
+    }
+
+} // namespace mstgen
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// distributions of random edge weights, a weight is computed from one random 64-bit number
+
+namespace mstgen {
+
+    enum class WeightDistribution {
+        // 1 ... 1000, the same as the BGL generator
+        Uniform,
+        // Pareto with alpha = 1.5 starting at 1, capped at 1000000: most weights are small, a few are huge
+        HeavyTailed,
+        // 1 ... 4, most comparisons are between equal weights
+        Ties
+    };
+
+    inline const char* weight_distribution_name(WeightDistribution distribution) {
+        switch (distribution) {
+        case WeightDistribution::HeavyTailed: return "heavy-tailed";
+        case WeightDistribution::Ties: return "ties";
+        default: return "uniform";
+        }
+    }
+
+    inline int weight_from(std::uint64_t random, WeightDistribution distribution) {
+        switch (distribution) {
+        case WeightDistribution::HeavyTailed: {
+            // uniform in (0, 1]
+            const double u = static_cast<double>((random >> 11) + 1) * 0x1.0p-53;
+            return static_cast<int>(std::min(1e6, std::floor(std::pow(u, -1.0 / 1.5))));
+        }
+        case WeightDistribution::Ties:
+            return 1 + static_cast<int>(random % 4);
+        default:
+            return 1 + static_cast<int>(random % 1000);
+        }
+    }
+
+} // namespace mstgen
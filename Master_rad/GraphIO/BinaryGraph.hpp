@@ -0,0 +1,272 @@
+#pragma once
+
+#include "../Generators/CSRGraph.hpp"
+#include "../Utils/TaskPool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// binary CSR graph file that is memory-mapped and used in place, without parsing or copying
+//
+// layout (version 1, native byte order, checked by the byteOrder field):
+//   header (128 bytes) | offsets: uint64[n + 1] | neighbors: int32[2m] | weights: int32[2m] | edge ids: uint32[2m] (optional)
+// every section starts at a multiple of 64 bytes, so the mapped arrays are aligned
+// each section has a checksum (see checksum()), the header has its own, verification on load is optional
+// the file is mapped read-only and shared, so several benchmark processes use the same copy in the page cache
+
+namespace mstio {
+
+    constexpr char binary_graph_magic[8] = { 'M', 'S', 'T', 'C', 'S', 'R', '\0', '\0' };
+    constexpr std::uint32_t binary_graph_version = 1;
+    constexpr std::uint32_t binary_graph_byte_order = 0x01020304;
+    constexpr std::uint32_t binary_graph_has_edge_ids = 1;
+
+    enum BinarySection { OffsetsSection, NeighborsSection, WeightsSection, EdgeIdsSection, SectionsNumber };
+
+    struct BinaryGraphHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byteOrder;
+        std::uint32_t flags;
+        std::uint32_t reserved;
+        std::uint64_t nodes;
+        // number of neighbor entries, twice the number of undirected edges
+        std::uint64_t entries;
+        // position of each section in the file, 0 for a missing section
+        std::uint64_t sectionOffsets[SectionsNumber];
+        std::uint64_t sectionChecksums[SectionsNumber];
+        std::uint64_t padding[2];
+        // checksum of all the fields above
+        std::uint64_t headerChecksum;
+    };
+    static_assert(sizeof(BinaryGraphHeader) == 128, "the header of the binary graph format has a fixed size");
+
+    // 64-bit hash of the data, independent of the number of workers:
+    // every 1 MiB block is hashed on its own and the block hashes are combined in order
+    inline std::uint64_t checksum(const void* data, std::size_t bytes, unsigned workersNumber = 0) {
+        constexpr std::size_t blockBytes = std::size_t{ 1 } << 20;
+        const auto* begin = static_cast<const unsigned char*>(data);
+        const std::size_t blocks = (bytes + blockBytes - 1) / blockBytes;
+
+        auto mix = [](std::uint64_t x) {
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+            return x ^ (x >> 31);
+        };
+
+        std::vector<std::uint64_t> hashes(blocks);
+        runTasks(blocks, [&](std::size_t block) {
+            const unsigned char* p = begin + block * blockBytes;
+            const std::size_t size = std::min(blockBytes, bytes - block * blockBytes);
+
+            std::uint64_t h = mix(block + 1), word = 0;
+            std::size_t i = 0;
+            for (; i + 8 <= size; i += 8) {
+                std::memcpy(&word, p + i, 8);
+                h = (h ^ mix(word)) * 0x9E3779B97F4A7C15ull;
+            }
+            word = 0;
+            std::memcpy(&word, p + i, size - i);
+            hashes[block] = mix(h ^ mix(word ^ size));
+        }, workersNumber);
+
+        std::uint64_t h = mix(bytes);
+        for (auto blockHash : hashes) {
+            h = mix(h ^ blockHash) * 0x9E3779B97F4A7C15ull;
+        }
+        return h;
+    }
+
+    inline std::uint64_t header_checksum(const BinaryGraphHeader& header) {
+        return checksum(&header, offsetof(BinaryGraphHeader, headerChecksum), 1);
+    }
+
+    // writes the graph, edge ids are stored when the graph has them
+    inline void write_binary_graph(const std::string& path, const mstgen::CSRView& g, unsigned workersNumber = 0) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) throw std::runtime_error("can't open " + path + " for writing");
+
+        const bool hasEdgeIds = !g.edgeIds.empty();
+        if (g.offsets.size() != g.nodesNumber() + 1 || g.weights.size() != g.neighbors.size()
+            || (hasEdgeIds && g.edgeIds.size() != g.neighbors.size())) {
+            throw std::runtime_error("inconsistent CSR arrays");
+        }
+
+        auto bytes = [](auto array) { return std::span<const unsigned char>(reinterpret_cast<const unsigned char*>(array.data()), array.size_bytes()); };
+        const std::span<const unsigned char> sections[SectionsNumber] = { bytes(g.offsets), bytes(g.neighbors), bytes(g.weights), bytes(g.edgeIds) };
+
+        BinaryGraphHeader header{};
+        std::memcpy(header.magic, binary_graph_magic, sizeof(header.magic));
+        header.version = binary_graph_version;
+        header.byteOrder = binary_graph_byte_order;
+        header.flags = hasEdgeIds ? binary_graph_has_edge_ids : 0;
+        header.nodes = g.nodesNumber();
+        header.entries = g.neighbors.size();
+
+        auto align = [](std::uint64_t position) { return (position + 63) / 64 * 64; };
+        std::uint64_t position = sizeof(BinaryGraphHeader);
+        for (int section = 0; section < SectionsNumber; ++section) {
+            if (section == EdgeIdsSection && !hasEdgeIds) continue;
+            position = align(position);
+            header.sectionOffsets[section] = position;
+            header.sectionChecksums[section] = checksum(sections[section].data(), sections[section].size(), workersNumber);
+            position += sections[section].size();
+        }
+        header.headerChecksum = header_checksum(header);
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        const char zeros[64] = {};
+        position = sizeof(BinaryGraphHeader);
+        for (int section = 0; section < SectionsNumber; ++section) {
+            if (!header.sectionOffsets[section]) continue;
+            file.write(zeros, static_cast<std::streamsize>(header.sectionOffsets[section] - position));
+            file.write(reinterpret_cast<const char*>(sections[section].data()), static_cast<std::streamsize>(sections[section].size()));
+            position = header.sectionOffsets[section] + sections[section].size();
+        }
+
+        if (!file.flush()) throw std::runtime_error("can't write " + path);
+    }
+
+    inline void write_binary_graph(const std::string& path, const mstgen::CSRGraph& g, unsigned workersNumber = 0) {
+        write_binary_graph(path, mstgen::view(g), workersNumber);
+    }
+
+    // read-only shared mapping of a whole file
+    class MappedFile {
+    public:
+        explicit MappedFile(const std::string& path) {
+#if defined(_WIN32)
+            m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+            if (m_file == INVALID_HANDLE_VALUE) throw std::runtime_error("can't open " + path);
+
+            LARGE_INTEGER size{};
+            GetFileSizeEx(m_file, &size);
+            m_size = static_cast<std::size_t>(size.QuadPart);
+            if (m_size) {
+                m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (m_mapping) m_data = MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+                if (!m_data) { close(); throw std::runtime_error("can't map " + path); }
+            }
+#else
+            m_file = ::open(path.c_str(), O_RDONLY);
+            if (m_file < 0) throw std::runtime_error("can't open " + path);
+
+            struct stat status {};
+            if (fstat(m_file, &status) != 0) { close(); throw std::runtime_error("can't read the size of " + path); }
+            m_size = static_cast<std::size_t>(status.st_size);
+            if (m_size) {
+                m_data = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, m_file, 0);
+                if (m_data == MAP_FAILED) { m_data = nullptr; close(); throw std::runtime_error("can't map " + path); }
+            }
+#endif
+        }
+
+        ~MappedFile() { close(); }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        const unsigned char* data() const { return static_cast<const unsigned char*>(m_data); }
+        std::size_t size() const { return m_size; }
+
+    private:
+        void close() {
+#if defined(_WIN32)
+            if (m_data) UnmapViewOfFile(m_data);
+            if (m_mapping) CloseHandle(m_mapping);
+            if (m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+            m_mapping = nullptr;
+            m_file = INVALID_HANDLE_VALUE;
+#else
+            if (m_data) munmap(m_data, m_size);
+            if (m_file >= 0) ::close(m_file);
+            m_file = -1;
+#endif
+            m_data = nullptr;
+        }
+
+#if defined(_WIN32)
+        HANDLE m_file{ INVALID_HANDLE_VALUE };
+        HANDLE m_mapping{ nullptr };
+#else
+        int m_file{ -1 };
+#endif
+        void* m_data{ nullptr };
+        std::size_t m_size{ 0 };
+    };
+
+    // graph used directly from the mapped file, view() stays valid while the object lives
+    // only the header is read on load, the arrays are paged in when they are used
+    class MappedGraph {
+    public:
+        // verifyChecksums reads the whole file, without it the load doesn't touch the arrays
+        explicit MappedGraph(const std::string& path, bool verifyChecksums = false, unsigned workersNumber = 0)
+            : m_file(path) {
+
+            if (m_file.size() < sizeof(BinaryGraphHeader)) throw std::runtime_error(path + " is not a binary graph");
+
+            BinaryGraphHeader header;
+            std::memcpy(&header, m_file.data(), sizeof(header));
+
+            if (std::memcmp(header.magic, binary_graph_magic, sizeof(header.magic)) != 0) throw std::runtime_error(path + " is not a binary graph");
+            if (header.byteOrder != binary_graph_byte_order) throw std::runtime_error(path + " has a different byte order");
+            if (header.version != binary_graph_version) {
+                throw std::runtime_error(path + " has version " + std::to_string(header.version) + ", supported is " + std::to_string(binary_graph_version));
+            }
+            if (header.headerChecksum != header_checksum(header)) throw std::runtime_error(path + " has a corrupted header");
+
+            const bool hasEdgeIds = header.flags & binary_graph_has_edge_ids;
+            const std::uint64_t sizes[SectionsNumber] = {
+                (header.nodes + 1) * sizeof(std::uint64_t), header.entries * sizeof(int), header.entries * sizeof(int),
+                hasEdgeIds ? header.entries * sizeof(std::uint32_t) : 0
+            };
+
+            for (int section = 0; section < SectionsNumber; ++section) {
+                if (section == EdgeIdsSection && !hasEdgeIds) continue;
+
+                const std::uint64_t begin = header.sectionOffsets[section];
+                if (begin % 64 || begin < sizeof(BinaryGraphHeader) || begin > m_file.size() || sizes[section] > m_file.size() - begin) {
+                    throw std::runtime_error(path + " is truncated or has invalid section offsets");
+                }
+                if (verifyChecksums && checksum(m_file.data() + begin, sizes[section], workersNumber) != header.sectionChecksums[section]) {
+                    throw std::runtime_error(path + " has a wrong checksum");
+                }
+            }
+
+            auto section = [&](int index) { return m_file.data() + header.sectionOffsets[index]; };
+            m_view.offsets = { reinterpret_cast<const std::uint64_t*>(section(OffsetsSection)), header.nodes + 1 };
+            m_view.neighbors = { reinterpret_cast<const int*>(section(NeighborsSection)), header.entries };
+            m_view.weights = { reinterpret_cast<const int*>(section(WeightsSection)), header.entries };
+            if (hasEdgeIds) m_view.edgeIds = { reinterpret_cast<const std::uint32_t*>(section(EdgeIdsSection)), header.entries };
+        }
+
+        const mstgen::CSRView& view() const { return m_view; }
+
+    private:
+        MappedFile m_file;
+        mstgen::CSRView m_view{};
+    };
+
+} // namespace mstio
@@ -0,0 +1,201 @@
+#pragma once
+
+#include "TextReaders.hpp"
+#include "../Generators/CSRGraph.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// edge streams for the engines that don't hold the graph in memory: the edges are read in batches with large sequential reads
+//
+// binary edge file (.mste, version 1, native byte order):
+//   header (32 bytes) | edges: { int32 u, int32 v, int32 weight }...
+// the edges are read until the end of the file, so an edge log can be appended to without touching the header
+// text edge lists ("u v [w]", see read_edge_list) are streamed too, their number of nodes is known only at the end
+
+namespace mstio {
+
+    struct StreamEdge {
+        int u;
+        int v;
+        int weight;
+    };
+    static_assert(sizeof(StreamEdge) == 12, "stream edges are stored as they are in memory");
+
+    constexpr char edge_stream_magic[8] = { 'M', 'S', 'T', 'E', 'D', 'G', 'E', '\0' };
+    constexpr std::uint32_t edge_stream_version = 1;
+
+    struct EdgeStreamHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byteOrder;
+        // 0 if unknown
+        std::uint64_t nodes;
+        std::uint64_t reserved;
+    };
+    static_assert(sizeof(EdgeStreamHeader) == 32, "the header of the edge stream format has a fixed size");
+
+    inline bool is_edge_stream_path(const std::string& path) {
+        return path.size() >= 5 && path.compare(path.size() - 5, 5, ".mste") == 0;
+    }
+
+    // writes every undirected edge of the graph once
+    inline void write_edge_stream(const std::string& path, const mstgen::CSRView& g) {
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file) throw std::runtime_error("can't open " + path + " for writing");
+
+        EdgeStreamHeader header{};
+        std::memcpy(header.magic, edge_stream_magic, sizeof(header.magic));
+        header.version = edge_stream_version;
+        header.byteOrder = binary_graph_byte_order;
+        header.nodes = g.nodesNumber();
+        bool written = std::fwrite(&header, sizeof(header), 1, file) == 1;
+
+        std::vector<StreamEdge> block;
+        block.reserve(1 << 16);
+        for (std::size_t u = 0; u < g.nodesNumber() && written; ++u) {
+            for (std::uint64_t i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+                if (static_cast<std::size_t>(g.neighbors[i]) > u) block.push_back({ static_cast<int>(u), g.neighbors[i], g.weights[i] });
+            }
+            if (block.size() >= (1 << 16) || u + 1 == g.nodesNumber()) {
+                written = std::fwrite(block.data(), sizeof(StreamEdge), block.size(), file) == block.size();
+                block.clear();
+            }
+        }
+
+        if (std::fclose(file) != 0 || !written) throw std::runtime_error("can't write " + path);
+    }
+
+    // reads the edges of a binary edge file or a text edge list in batches, without keeping more than a batch in memory
+    class EdgeStreamReader {
+    public:
+        explicit EdgeStreamReader(const std::string& path, std::size_t bufferBytes = std::size_t{ 16 } << 20)
+            : m_path(path), m_binary(is_edge_stream_path(path)), m_buffer(m_binary ? 0 : bufferBytes) {
+
+            m_file = std::fopen(path.c_str(), "rb");
+            if (!m_file) throw std::runtime_error("can't open " + path);
+
+            if (m_binary) {
+                EdgeStreamHeader header{};
+                if (std::fread(&header, sizeof(header), 1, m_file) != 1 || std::memcmp(header.magic, edge_stream_magic, sizeof(header.magic)) != 0) {
+                    std::fclose(m_file);
+                    throw std::runtime_error(path + " is not an edge stream");
+                }
+                if (header.byteOrder != binary_graph_byte_order || header.version != edge_stream_version) {
+                    std::fclose(m_file);
+                    throw std::runtime_error(path + " has an unsupported version or byte order");
+                }
+                m_nodesNumber = header.nodes;
+            }
+        }
+
+        ~EdgeStreamReader() { std::fclose(m_file); }
+
+        EdgeStreamReader(const EdgeStreamReader&) = delete;
+        EdgeStreamReader& operator=(const EdgeStreamReader&) = delete;
+
+        // replaces the batch with the next maxEdges edges (fewer at the end), returns false when there are no more edges
+        bool read(std::vector<StreamEdge>& batch, std::size_t maxEdges) {
+            batch.clear();
+            if (m_binary) {
+                // the batch grows with the data, so a big limit doesn't touch memory the file doesn't fill
+                const std::size_t blockEdges = std::size_t{ 1 } << 20;
+                while (batch.size() < maxEdges) {
+                    const std::size_t size = batch.size(), wanted = std::min(maxEdges - size, blockEdges);
+                    batch.resize(size + wanted);
+                    const std::size_t edges = std::fread(batch.data() + size, sizeof(StreamEdge), wanted, m_file);
+                    batch.resize(size + edges);
+                    if (edges < wanted) {
+                        if (std::ferror(m_file)) throw std::runtime_error("can't read " + m_path);
+                        break;
+                    }
+                }
+            }
+            else {
+                readText(batch, maxEdges);
+            }
+
+            for (const auto& edge : batch) {
+                if (edge.u < 0 || edge.v < 0) throw std::runtime_error(m_path + " has a negative node");
+                m_nodesNumber = std::max<std::size_t>(m_nodesNumber, static_cast<std::size_t>(std::max(edge.u, edge.v)) + 1);
+            }
+            return !batch.empty();
+        }
+
+        // number of nodes of the header or the largest node read so far + 1
+        std::size_t nodesNumber() const { return m_nodesNumber; }
+
+        // true if the number of nodes is known before the edges are read
+        bool knowsNodesNumber() const { return m_binary; }
+
+    private:
+        // parses the whole lines in the buffer, the unfinished last line is moved to the beginning for the next read
+        void readText(std::vector<StreamEdge>& batch, std::size_t maxEdges) {
+            while (batch.size() < maxEdges) {
+                const char* p = m_buffer.data() + m_begin;
+                const char* end = m_buffer.data() + m_end;
+                const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+
+                if (!lineEnd) {
+                    if (m_eof) {
+                        if (p < end) parseLine(p, end, batch);
+                        m_begin = m_end;
+                        return;
+                    }
+                    fill();
+                    continue;
+                }
+
+                parseLine(p, lineEnd, batch);
+                m_begin = static_cast<std::size_t>(lineEnd + 1 - m_buffer.data());
+                m_line++;
+            }
+        }
+
+        void fill() {
+            std::memmove(m_buffer.data(), m_buffer.data() + m_begin, m_end - m_begin);
+            m_end -= m_begin;
+            m_begin = 0;
+            if (m_end == m_buffer.size()) m_buffer.resize(2 * m_buffer.size());
+
+            const std::size_t bytes = std::fread(m_buffer.data() + m_end, 1, m_buffer.size() - m_end, m_file);
+            if (bytes < m_buffer.size() - m_end) {
+                if (std::ferror(m_file)) throw std::runtime_error("can't read " + m_path);
+                m_eof = true;
+            }
+            m_end += bytes;
+        }
+
+        void parseLine(const char* p, const char* lineEnd, std::vector<StreamEdge>& batch) {
+            if (!detail::skip_spaces(p, lineEnd) || *p == '#' || *p == '%') return;
+
+            long long u = 0, v = 0;
+            int weight = 1;
+            if (!detail::parse_number(p, lineEnd, u) || !detail::parse_number(p, lineEnd, v)
+                || (!detail::at_line_end(p, lineEnd) && !detail::parse_number(p, lineEnd, weight))
+                || u > std::numeric_limits<int>::max() || v > std::numeric_limits<int>::max()) {
+                throw std::runtime_error(m_path + ":" + std::to_string(m_line) + ": invalid edge");
+            }
+            batch.push_back({ static_cast<int>(u), static_cast<int>(v), weight });
+        }
+
+        std::string m_path;
+        bool m_binary{ false };
+        std::FILE* m_file{ nullptr };
+        std::size_t m_nodesNumber{ 0 };
+
+        // text: the unparsed bytes are m_buffer[m_begin, m_end)
+        std::vector<char> m_buffer;
+        std::size_t m_begin{ 0 };
+        std::size_t m_end{ 0 };
+        std::size_t m_line{ 1 };
+        bool m_eof{ false };
+    };
+
+} // namespace mstio
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "BinaryGraph.hpp"
+#include "TextReaders.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// graph file of any supported format, binary graphs stay mapped and text graphs are parsed into memory
+
+namespace mstio {
+
+    enum class GraphFormat { Auto, Binary, Dimacs, Metis, MatrixMarket, EdgeList };
+
+    inline std::vector<GraphFormat> graph_formats() {
+        return { GraphFormat::Auto, GraphFormat::Binary, GraphFormat::Dimacs, GraphFormat::Metis, GraphFormat::MatrixMarket, GraphFormat::EdgeList };
+    }
+
+    inline std::string graph_format_name(GraphFormat format) {
+        switch (format) {
+        case GraphFormat::Binary: return "binary";
+        case GraphFormat::Dimacs: return "dimacs";
+        case GraphFormat::Metis: return "metis";
+        case GraphFormat::MatrixMarket: return "mtx";
+        case GraphFormat::EdgeList: return "edges";
+        default: return "auto";
+        }
+    }
+
+    // format by the extension: .mstg, .gr, .graph or .metis, .mtx, anything else is an edge list
+    inline GraphFormat detect_graph_format(const std::string& path) {
+        auto endsWith = [&](const std::string& suffix) {
+            return path.size() >= suffix.size() && path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0;
+        };
+
+        if (endsWith(".mstg")) return GraphFormat::Binary;
+        if (endsWith(".gr")) return GraphFormat::Dimacs;
+        if (endsWith(".graph") || endsWith(".metis")) return GraphFormat::Metis;
+        if (endsWith(".mtx")) return GraphFormat::MatrixMarket;
+        return GraphFormat::EdgeList;
+    }
+
+    class GraphFile {
+    public:
+        // verifyChecksums applies only to binary graphs
+        explicit GraphFile(const std::string& path, GraphFormat format = GraphFormat::Auto, bool verifyChecksums = false, unsigned workersNumber = 0) {
+            if (format == GraphFormat::Auto) format = detect_graph_format(path);
+
+            switch (format) {
+            case GraphFormat::Binary:
+                m_mapped = std::make_unique<MappedGraph>(path, verifyChecksums, workersNumber);
+                m_view = m_mapped->view();
+                return;
+            case GraphFormat::Dimacs: m_graph = read_text_graph(path, TextFormat::Dimacs, workersNumber); break;
+            case GraphFormat::Metis: m_graph = read_text_graph(path, TextFormat::Metis, workersNumber); break;
+            case GraphFormat::MatrixMarket: m_graph = read_text_graph(path, TextFormat::MatrixMarket, workersNumber); break;
+            default: m_graph = read_text_graph(path, TextFormat::EdgeList, workersNumber); break;
+            }
+            m_view = mstgen::view(m_graph);
+        }
+
+        GraphFile(const GraphFile&) = delete;
+        GraphFile& operator=(const GraphFile&) = delete;
+
+        const mstgen::CSRView& view() const { return m_view; }
+
+    private:
+        std::unique_ptr<MappedGraph> m_mapped{};
+        mstgen::CSRGraph m_graph{};
+        mstgen::CSRView m_view{};
+    };
+
+} // namespace mstio
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "BinaryGraph.hpp"
+#include "../Utils/MSTResult.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// binary file of a minimum spanning forest (.msts, version 1, native byte order):
+//   header (48 bytes) | edges: { int32 u, int32 v, int32 weight }... | ids: uint64 per edge | parent: int32 per node
+// the sections are written straight from the MSTResult in blocks, the ids are ~0 for the streaming engines
+
+namespace mstio {
+
+    constexpr char mst_result_magic[8] = { 'M', 'S', 'T', 'R', 'E', 'S', '\0', '\0' };
+    constexpr std::uint32_t mst_result_version = 1;
+
+    struct MSTResultHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byteOrder;
+        std::uint64_t nodes;
+        std::uint64_t edges;
+        std::uint64_t components;
+        std::int64_t totalWeight;
+    };
+    static_assert(sizeof(MSTResultHeader) == 48, "the header of the MST result format has a fixed size");
+
+    inline void write_mst_result(const std::string& path, const MSTResult<>& result) {
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file) throw std::runtime_error("can't open " + path + " for writing");
+
+        MSTResultHeader header{};
+        std::memcpy(header.magic, mst_result_magic, sizeof(header.magic));
+        header.version = mst_result_version;
+        header.byteOrder = binary_graph_byte_order;
+        header.nodes = result.parent.size();
+        header.edges = result.edges.size();
+        header.components = result.componentsNumber;
+        header.totalWeight = static_cast<std::int64_t>(result.totalWeight);
+        bool written = std::fwrite(&header, sizeof(header), 1, file) == 1;
+
+        // the edges are stored without their ids (and padding), the ids follow as their own section
+        const std::size_t blockEdges = std::size_t{ 1 } << 16;
+        std::vector<std::int32_t> block;
+        block.reserve(3 * blockEdges);
+        for (std::size_t i = 0; i < result.edges.size() && written; ++i) {
+            block.insert(block.end(), { result.edges[i].u, result.edges[i].v, result.edges[i].weight });
+            if (block.size() == 3 * blockEdges || i + 1 == result.edges.size()) {
+                written = std::fwrite(block.data(), sizeof(std::int32_t), block.size(), file) == block.size();
+                block.clear();
+            }
+        }
+
+        std::vector<std::uint64_t> ids;
+        ids.reserve(blockEdges);
+        for (std::size_t i = 0; i < result.edges.size() && written; ++i) {
+            ids.push_back(result.edges[i].id);
+            if (ids.size() == blockEdges || i + 1 == result.edges.size()) {
+                written = std::fwrite(ids.data(), sizeof(std::uint64_t), ids.size(), file) == ids.size();
+                ids.clear();
+            }
+        }
+
+        if (written && !result.parent.empty()) {
+            written = std::fwrite(result.parent.data(), sizeof(int), result.parent.size(), file) == result.parent.size();
+        }
+
+        if (std::fclose(file) != 0 || !written) throw std::runtime_error("can't write " + path);
+    }
+
+    inline MSTResult<> read_mst_result(const std::string& path) {
+        std::FILE* file = std::fopen(path.c_str(), "rb");
+        if (!file) throw std::runtime_error("can't open " + path);
+
+        auto fail = [&](const std::string& message) {
+            std::fclose(file);
+            throw std::runtime_error(path + ' ' + message);
+        };
+
+        MSTResultHeader header{};
+        if (std::fread(&header, sizeof(header), 1, file) != 1 || std::memcmp(header.magic, mst_result_magic, sizeof(header.magic)) != 0) {
+            fail("is not an MST result");
+        }
+        if (header.byteOrder != binary_graph_byte_order || header.version != mst_result_version) {
+            fail("has an unsupported version or byte order");
+        }
+
+        std::vector<std::int32_t> ends(3 * header.edges);
+        std::vector<std::uint64_t> ids(header.edges);
+        std::vector<int> parent(header.nodes);
+        if (std::fread(ends.data(), sizeof(std::int32_t), ends.size(), file) != ends.size() ||
+            std::fread(ids.data(), sizeof(std::uint64_t), ids.size(), file) != ids.size() ||
+            std::fread(parent.data(), sizeof(int), parent.size(), file) != parent.size()) {
+            fail("is truncated");
+        }
+        std::fclose(file);
+
+        std::vector<MSTEdge<>> edges(header.edges);
+        for (std::size_t i = 0; i < edges.size(); ++i) {
+            edges[i] = { ends[3 * i], ends[3 * i + 1], ends[3 * i + 2], ids[i] };
+        }
+
+        // the parent links and the trees are built again from the edges, the same way they were written
+        auto result = buildMSTResult(static_cast<std::size_t>(header.nodes), std::move(edges));
+        if (result.parent != parent || result.componentsNumber != header.components) throw std::runtime_error(path + " has inconsistent parent links");
+        return result;
+    }
+
+} // namespace mstio
@@ -0,0 +1,377 @@
+#pragma once
+
+#include "BinaryGraph.hpp"
+#include "../Generators/CSRGraph.hpp"
+#include "../Utils/ParallelSort.h"
+#include "../Utils/TaskPool.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+// readers of text graph formats: DIMACS .gr, METIS, Matrix Market and whitespace edge lists
+// the file is memory-mapped and split into chunks at line boundaries, every chunk is parsed by its own worker
+// with std::from_chars, and the edges go straight into CSR
+// the graphs are undirected: both directions of an edge become one edge, parallel edges keep the smallest weight
+// and loops are dropped, so every format gives the input the engines expect
+
+namespace mstio {
+
+    enum class TextFormat { Dimacs, Metis, MatrixMarket, EdgeList };
+
+    namespace detail {
+
+        inline bool is_space(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+        // skips spaces and tabs, false at the end of the line
+        inline bool skip_spaces(const char*& p, const char* end) {
+            while (p < end && is_space(*p)) p++;
+            return p < end && *p != '\n';
+        }
+
+        template<typename T>
+        bool parse_number(const char*& p, const char* end, T& value) {
+            if (!skip_spaces(p, end)) return false;
+            auto [next, error] = std::from_chars(p, end, value);
+            if (error != std::errc{}) return false;
+            p = next;
+            return true;
+        }
+
+        // the first character after the end of the line
+        inline const char* next_line(const char* p, const char* end) {
+            while (p < end && *p != '\n') p++;
+            return p < end ? p + 1 : end;
+        }
+
+        inline bool at_line_end(const char*& p, const char* end) {
+            return !skip_spaces(p, end);
+        }
+
+        // 1-based number of the line that contains the position, counted only when an error is reported
+        inline std::size_t line_number(const char* data, const char* p) {
+            return 1 + static_cast<std::size_t>(std::count(data, p, '\n'));
+        }
+
+        // chunks of data[begin, end) that start at the beginnings of lines, the result has chunks + 1 positions
+        inline std::vector<std::size_t> line_chunks(const char* data, std::size_t begin, std::size_t end, unsigned workersNumber) {
+            const std::size_t minChunk = 1 << 20;
+            const std::size_t workers = workersNumber ? workersNumber : defaultWorkersNumber();
+            const std::size_t chunks = std::max<std::size_t>(1, std::min((end - begin) / minChunk, 4 * workers));
+
+            std::vector<std::size_t> bounds(chunks + 1);
+            bounds[0] = begin;
+            bounds[chunks] = end;
+            for (std::size_t chunk = 1; chunk < chunks; ++chunk) {
+                const char* p = data + begin + chunk * (end - begin) / chunks;
+                // a chunk starting right after '\n' is at a line beginning, otherwise it starts at the next line
+                if (data[p - data - 1] != '\n') p = next_line(p, data + end);
+                bounds[chunk] = std::max(bounds[chunk - 1], static_cast<std::size_t>(p - data));
+            }
+            return bounds;
+        }
+
+        [[noreturn]] inline void parse_error(const std::string& path, const char* data, const char* p, const std::string& message) {
+            throw std::runtime_error(path + ":" + std::to_string(line_number(data, p)) + ": " + message);
+        }
+
+        // undirected edges of all chunks, in the chunk order
+        struct ChunkEdges {
+            std::vector<mstgen::PackedEdge> edges{};
+        };
+
+        inline std::vector<mstgen::PackedEdge> concatenate(std::vector<ChunkEdges>& chunks, unsigned workersNumber) {
+            std::vector<std::size_t> starts(chunks.size() + 1, 0);
+            for (std::size_t chunk = 0; chunk < chunks.size(); ++chunk) {
+                starts[chunk + 1] = starts[chunk] + chunks[chunk].edges.size();
+            }
+
+            std::vector<mstgen::PackedEdge> edges(starts.back());
+            runTasks(chunks.size(), [&](std::size_t chunk) {
+                std::copy(chunks[chunk].edges.begin(), chunks[chunk].edges.end(), edges.begin() + starts[chunk]);
+                chunks[chunk].edges = {};
+            }, workersNumber);
+            return edges;
+        }
+
+        // sorts the edges, keeps the lightest of the parallel ones and builds CSR
+        inline mstgen::CSRGraph build_csr(std::size_t n, std::vector<mstgen::PackedEdge> edges, unsigned workersNumber) {
+            parallelRadixSort(edges, [](const mstgen::PackedEdge& edge) { return edge.key; }, workersNumber);
+
+            std::size_t distinct = 0;
+            for (std::size_t i = 0; i < edges.size(); ++i) {
+                if (distinct && edges[distinct - 1].key == edges[i].key) {
+                    edges[distinct - 1].weight = std::min(edges[distinct - 1].weight, edges[i].weight);
+                }
+                else {
+                    edges[distinct++] = edges[i];
+                }
+            }
+            edges.resize(distinct);
+
+            return mstgen::to_csr(n, edges);
+        }
+
+        // adds the edge between 0-based nodes, loops are skipped
+        inline bool add_edge(ChunkEdges& chunk, long long u, long long v, int weight, std::size_t n) {
+            if (u < 0 || v < 0 || static_cast<std::size_t>(u) >= n || static_cast<std::size_t>(v) >= n) return false;
+            if (u != v) chunk.edges.push_back({ mstgen::pack_undirected_edge(static_cast<std::uint64_t>(u), static_cast<std::uint64_t>(v)), weight });
+            return true;
+        }
+
+        // parses the lines of [begin, end) in parallel, parseLine(p, lineEnd, chunk) returns an error message or nullptr
+        // comment lines (starting with one of the comment characters) and blank lines are skipped
+        template<typename ParseLine>
+        std::vector<mstgen::PackedEdge> parse_edge_lines(const std::string& path, const char* data, std::size_t begin, std::size_t end,
+            std::string_view comments, ParseLine parseLine, unsigned workersNumber) {
+
+            const auto bounds = line_chunks(data, begin, end, workersNumber);
+            std::vector<ChunkEdges> chunks(bounds.size() - 1);
+
+            runTasks(chunks.size(), [&](std::size_t chunk) {
+                const char* p = data + bounds[chunk];
+                const char* chunkEnd = data + bounds[chunk + 1];
+
+                while (p < chunkEnd) {
+                    const char* lineEnd = p;
+                    while (lineEnd < chunkEnd && *lineEnd != '\n') lineEnd++;
+
+                    const char* first = p;
+                    if (skip_spaces(first, lineEnd) && comments.find(*first) == std::string_view::npos) {
+                        if (const char* error = parseLine(first, lineEnd, chunks[chunk])) parse_error(path, data, p, error);
+                    }
+                    p = lineEnd < chunkEnd ? lineEnd + 1 : chunkEnd;
+                }
+            }, workersNumber);
+
+            return concatenate(chunks, workersNumber);
+        }
+
+        inline std::string_view text(const MappedFile& file) {
+            return { reinterpret_cast<const char*>(file.data()), file.size() };
+        }
+
+    } // namespace detail
+
+    // DIMACS shortest path format (.gr): "c" comments, "p sp n m" and arcs "a u v w" with 1-based nodes
+    inline mstgen::CSRGraph read_dimacs(const std::string& path, unsigned workersNumber = 0) {
+        MappedFile file(path);
+        const auto data = detail::text(file);
+        const char* begin = data.data();
+        const char* end = begin + data.size();
+
+        // the problem line comes before the arcs
+        std::size_t n = 0;
+        const char* p = begin;
+        for (; p < end; p = detail::next_line(p, end)) {
+            const char* q = p;
+            if (!detail::skip_spaces(q, end) || *q == 'c') continue;
+            if (*q != 'p') detail::parse_error(path, begin, p, "arc before the problem line");
+
+            q++;
+            while (q < end && detail::is_space(*q)) q++;
+            while (q < end && !detail::is_space(*q) && *q != '\n') q++;
+            long long nodes = 0, arcs = 0;
+            if (!detail::parse_number(q, end, nodes) || !detail::parse_number(q, end, arcs) || nodes < 0) {
+                detail::parse_error(path, begin, p, "invalid problem line");
+            }
+            n = static_cast<std::size_t>(nodes);
+            p = detail::next_line(p, end);
+            break;
+        }
+
+        auto edges = detail::parse_edge_lines(path, begin, static_cast<std::size_t>(p - begin), data.size(), "c",
+            [&](const char* q, const char* lineEnd, detail::ChunkEdges& chunk) -> const char* {
+                if (*q++ != 'a') return "expected an arc line";
+                long long u = 0, v = 0;
+                int weight = 0;
+                if (!detail::parse_number(q, lineEnd, u) || !detail::parse_number(q, lineEnd, v) || !detail::parse_number(q, lineEnd, weight)) {
+                    return "invalid arc";
+                }
+                if (!detail::add_edge(chunk, u - 1, v - 1, weight, n)) return "node out of range";
+                return nullptr;
+            }, workersNumber);
+
+        return detail::build_csr(n, std::move(edges), workersNumber);
+    }
+
+    // METIS graph format: "%" comments, the header "n m [fmt [ncon]]" and then one line per node (1-based) with its neighbors
+    // fmt 1 adds the weight after each neighbor, fmt 10 adds ncon node weights and fmt 100 a node size at the beginning of the lines
+    // edges without weights weigh 1
+    inline mstgen::CSRGraph read_metis(const std::string& path, unsigned workersNumber = 0) {
+        MappedFile file(path);
+        const auto data = detail::text(file);
+        const char* begin = data.data();
+        const char* end = begin + data.size();
+
+        std::size_t n = 0;
+        int format = 0, constraints = 1;
+        const char* p = begin;
+        for (bool header = false; p < end && !header; p = detail::next_line(p, end)) {
+            const char* q = p;
+            if (!detail::skip_spaces(q, end) || *q == '%') continue;
+
+            long long nodes = 0, edges = 0;
+            if (!detail::parse_number(q, end, nodes) || !detail::parse_number(q, end, edges) || nodes < 0) {
+                detail::parse_error(path, begin, p, "invalid header");
+            }
+            if (!detail::at_line_end(q, end) && !detail::parse_number(q, end, format)) detail::parse_error(path, begin, p, "invalid format");
+            if (!detail::at_line_end(q, end) && !detail::parse_number(q, end, constraints)) detail::parse_error(path, begin, p, "invalid ncon");
+            n = static_cast<std::size_t>(nodes);
+            header = true;
+        }
+
+        const bool edgeWeights = format % 10 == 1;
+        const int skipped = (format / 10 % 10 == 1 ? constraints : 0) + (format / 100 % 10 == 1 ? 1 : 0);
+
+        // the node of a line is its index among the non-comment lines, so the lines of each chunk are counted first
+        const std::size_t start = static_cast<std::size_t>(p - begin);
+        const auto bounds = detail::line_chunks(begin, start, data.size(), workersNumber);
+        const std::size_t chunksNumber = bounds.size() - 1;
+
+        auto isComment = [&](const char* line, const char* lineEnd) {
+            return detail::skip_spaces(line, lineEnd) && *line == '%';
+        };
+
+        std::vector<std::size_t> firstNode(chunksNumber + 1, 0);
+        runTasks(chunksNumber, [&](std::size_t chunk) {
+            std::size_t lines = 0;
+            for (const char* line = begin + bounds[chunk]; line < begin + bounds[chunk + 1]; line = detail::next_line(line, end)) {
+                const char* lineEnd = line;
+                while (lineEnd < end && *lineEnd != '\n') lineEnd++;
+                if (!isComment(line, lineEnd)) lines++;
+            }
+            firstNode[chunk + 1] = lines;
+        }, workersNumber);
+        for (std::size_t chunk = 0; chunk < chunksNumber; ++chunk) {
+            firstNode[chunk + 1] += firstNode[chunk];
+        }
+
+        std::vector<detail::ChunkEdges> chunks(chunksNumber);
+        runTasks(chunksNumber, [&](std::size_t chunk) {
+            std::size_t u = firstNode[chunk];
+            for (const char* line = begin + bounds[chunk]; line < begin + bounds[chunk + 1]; line = detail::next_line(line, end)) {
+                const char* lineEnd = line;
+                while (lineEnd < end && *lineEnd != '\n') lineEnd++;
+                if (isComment(line, lineEnd)) continue;
+
+                const char* q = line;
+                if (u >= n) {
+                    // blank lines after the last node are allowed
+                    if (detail::at_line_end(q, lineEnd)) continue;
+                    detail::parse_error(path, begin, line, "more node lines than nodes in the header");
+                }
+
+                long long value = 0;
+                for (int i = 0; i < skipped; ++i) {
+                    if (!detail::parse_number(q, lineEnd, value)) detail::parse_error(path, begin, line, "missing node weight");
+                }
+                while (!detail::at_line_end(q, lineEnd)) {
+                    long long v = 0;
+                    int weight = 1;
+                    if (!detail::parse_number(q, lineEnd, v)) detail::parse_error(path, begin, line, "invalid neighbor");
+                    if (edgeWeights && !detail::parse_number(q, lineEnd, weight)) detail::parse_error(path, begin, line, "missing edge weight");
+                    if (!detail::add_edge(chunks[chunk], static_cast<long long>(u), v - 1, weight, n)) {
+                        detail::parse_error(path, begin, line, "node out of range");
+                    }
+                }
+                u++;
+            }
+        }, workersNumber);
+
+        return detail::build_csr(n, detail::concatenate(chunks, workersNumber), workersNumber);
+    }
+
+    // Matrix Market coordinate format: the banner "%%MatrixMarket matrix coordinate <field> <symmetry>", "%" comments,
+    // the size line "rows columns entries" and the entries "i j [value]" with 1-based indices
+    // the matrix is read as an adjacency matrix of max(rows, columns) nodes, real values are rounded to integer weights
+    // and pattern matrices get weight 1
+    inline mstgen::CSRGraph read_matrix_market(const std::string& path, unsigned workersNumber = 0) {
+        MappedFile file(path);
+        const auto data = detail::text(file);
+        const char* begin = data.data();
+        const char* end = begin + data.size();
+
+        const std::string_view banner = data.substr(0, static_cast<std::size_t>(detail::next_line(begin, end) - begin));
+        if (banner.rfind("%%MatrixMarket", 0) != 0) detail::parse_error(path, begin, begin, "missing %%MatrixMarket banner");
+        if (banner.find("coordinate") == std::string_view::npos) detail::parse_error(path, begin, begin, "only the coordinate format is supported");
+        if (banner.find("complex") != std::string_view::npos) detail::parse_error(path, begin, begin, "complex matrices are not supported");
+        const bool pattern = banner.find("pattern") != std::string_view::npos;
+
+        std::size_t n = 0;
+        const char* p = detail::next_line(begin, end);
+        for (bool size = false; p < end && !size; p = detail::next_line(p, end)) {
+            const char* q = p;
+            if (!detail::skip_spaces(q, end) || *q == '%') continue;
+
+            long long rows = 0, columns = 0, entries = 0;
+            if (!detail::parse_number(q, end, rows) || !detail::parse_number(q, end, columns) || !detail::parse_number(q, end, entries)
+                || rows < 0 || columns < 0) {
+                detail::parse_error(path, begin, p, "invalid size line");
+            }
+            n = static_cast<std::size_t>(std::max(rows, columns));
+            size = true;
+        }
+
+        auto edges = detail::parse_edge_lines(path, begin, static_cast<std::size_t>(p - begin), data.size(), "%",
+            [&](const char* q, const char* lineEnd, detail::ChunkEdges& chunk) -> const char* {
+                long long i = 0, j = 0;
+                if (!detail::parse_number(q, lineEnd, i) || !detail::parse_number(q, lineEnd, j)) return "invalid entry";
+
+                int weight = 1;
+                if (!pattern) {
+                    double value = 0;
+                    if (!detail::parse_number(q, lineEnd, value)) return "missing value";
+                    if (!(std::abs(value) < static_cast<double>(std::numeric_limits<int>::max()))) return "value out of the weight range";
+                    weight = static_cast<int>(std::llround(value));
+                }
+                if (!detail::add_edge(chunk, i - 1, j - 1, weight, n)) return "index out of range";
+                return nullptr;
+            }, workersNumber);
+
+        return detail::build_csr(n, std::move(edges), workersNumber);
+    }
+
+    // whitespace separated "u v [w]" lines with 0-based nodes, "#" and "%" comments, edges without weights weigh 1
+    // the number of nodes is the largest node + 1
+    inline mstgen::CSRGraph read_edge_list(const std::string& path, unsigned workersNumber = 0) {
+        MappedFile file(path);
+        const auto data = detail::text(file);
+        const char* begin = data.data();
+
+        const std::size_t unknown = static_cast<std::size_t>(std::numeric_limits<int>::max());
+        auto edges = detail::parse_edge_lines(path, begin, 0, data.size(), "#%",
+            [&](const char* q, const char* lineEnd, detail::ChunkEdges& chunk) -> const char* {
+                long long u = 0, v = 0;
+                int weight = 1;
+                if (!detail::parse_number(q, lineEnd, u) || !detail::parse_number(q, lineEnd, v)) return "invalid edge";
+                if (!detail::at_line_end(q, lineEnd) && !detail::parse_number(q, lineEnd, weight)) return "invalid weight";
+                if (!detail::add_edge(chunk, u, v, weight, unknown)) return "node out of range";
+                return nullptr;
+            }, workersNumber);
+
+        std::size_t n = 0;
+        for (const auto& edge : edges) {
+            n = std::max(n, static_cast<std::size_t>(mstgen::edge_target(edge.key)) + 1);
+        }
+        return detail::build_csr(n, std::move(edges), workersNumber);
+    }
+
+    inline mstgen::CSRGraph read_text_graph(const std::string& path, TextFormat format, unsigned workersNumber = 0) {
+        switch (format) {
+        case TextFormat::Dimacs: return read_dimacs(path, workersNumber);
+        case TextFormat::Metis: return read_metis(path, workersNumber);
+        case TextFormat::MatrixMarket: return read_matrix_market(path, workersNumber);
+        default: return read_edge_list(path, workersNumber);
+        }
+    }
+
+} // namespace mstio
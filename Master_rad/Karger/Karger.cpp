@@ -1,4 +1,7 @@
 #include "Verifier.hpp"
+#include "../Utils/PhaseTimer.h"
+#include "../Utils/Log.h"
+#include "../Utils/MSTResult.h"
 
 #include <iostream>
 
@@ -53,13 +56,36 @@ struct pair_hash
 
 class KargerAlgorithm {
 public:
+	// an engine kept for many graphs (Utils/MSTEngine.h) calls prepare and solve for each of them
+	KargerAlgorithm() = default;
+
 	KargerAlgorithm(vector<vector<pair<int, int>>>& adjacencyList)
-		: m_adjacencyList(adjacencyList)
 	{
+		prepare(adjacencyList);
+		solve();
+
+		MST_LOG(Debug, "Karger: " << m_mstWeight);
+	}
+
+	// binds the graph, the list of the initial edges keeps its memory
+	// the recursion builds its own graphs, they are not reused
+	void prepare(vector<vector<pair<int, int>>>& adjacencyList) {
+		m_adjacencyList = &adjacencyList;
+		m_nodesNumber = adjacencyList.size();
+		m_edges.clear();
+		m_result.clear();
+		m_mstWeight = 0;
+		m_phases = {};
+	}
+
+	void solve() {
+		PhaseTimer timer;
+
 		// create initial graph of adjacencyList
-		int n = adjacencyList.size();
+		const auto& adjacencyList = *m_adjacencyList;
+		int n = m_nodesNumber;
 		int index = 0;
-		vector<tuple<int, int, int, int>> edges = {};
+		vector<tuple<int, int, int, int>>& edges = m_edges;
 
 		for (int i = 0; i < n; ++i) {
 			for (int j = 0; j < adjacencyList[i].size(); ++j) {
@@ -73,20 +99,19 @@ public:
 		}
 
 		Graph graph = Graph(n, edges);
+		timer.finish(m_phases.conversion);
 
-		auto start = Clock::now();
-		unordered_set<int> result = findMST(graph, 0);
-		auto end = Clock::now();
-
-		m_duration = std::chrono::duration_cast<ms>(end - start).count();
+		m_result = findMST(graph, 0);
+		timer.finish(m_phases.core);
 
 		// print result:
-		for (int edgeIndex : result) {
+		for (int edgeIndex : m_result) {
 			//cout << "( " << get<0>(graph.edges[edgeIndex]) << ", " << get<1>(graph.edges[edgeIndex]) << ") weight: " << get<2>(graph.edges[edgeIndex]) << endl;
 			m_mstWeight += get<2>(graph.edges[edgeIndex]);
 		}
+		timer.finish(m_phases.materialization);
 
-		cout << "Karger: " << m_mstWeight << endl;
+		m_duration = m_phases.total();
 	}
 
 	struct Graph {		
@@ -391,9 +416,33 @@ public:
 
 	double getDuration() { return m_duration; }
 
+	PhaseTimes getPhaseTimes() { return m_phases; }
+
+	// visit(u, v, weight, id) for each MST edge, the id is the index of the edge in the initial graph
+	template<typename Visit>
+	void forEachMSTEdge(Visit visit) {
+		for (int edgeIndex : m_result) {
+			const auto& [u, v, weight, index] = m_edges[edgeIndex];
+			visit(u, v, weight, index);
+		}
+	}
+
+	MSTResult<> getResult() {
+		vector<MSTEdge<>> edges;
+		edges.reserve(m_result.size());
+		forEachMSTEdge([&](int u, int v, int weight, int id) { edges.push_back({ u, v, weight, static_cast<uint64_t>(id) }); });
+		return buildMSTResult(static_cast<size_t>(m_nodesNumber), move(edges));
+	}
+
 private:
+	int m_nodesNumber{ 0 };
+	// edges of the initial graph and the indices of the MST edges among them
+	vector<tuple<int, int, int, int>> m_edges;
+	unordered_set<int> m_result;
+
 	size_t m_mstWeight{ 0 };
 	double m_duration{ 0 };
+	PhaseTimes m_phases{};
 
-	vector<vector<pair<int, int>>>& m_adjacencyList;
+	vector<vector<pair<int, int>>>* m_adjacencyList{ nullptr };
 };
\ No newline at end of file
@@ -73,28 +73,33 @@ fbt_reduction(const vector<tuple<int, int, int, int>>& edges,
 		// This lambda functions explores the current graph.
 		// This is required, because next we will merge each
 		// of the connected components into a single new node
-		function<void(int, int)> explore_cc = [&](int root, int parent) {
-			if (parent == -1)
+		// The traversal uses an explicit stack, the components can be as deep as
+		// the whole graph.
+		auto explore_cc = [&](int root) {
+			int new_id = prox_node_id++;
+			new_component_ids.push_back(new_id);
+			super_node_id[root] = new_id;
+
+			vector<int> stack{ root };
+			while (!stack.empty())
 			{
-				int new_id = prox_node_id++;
-				new_component_ids.push_back(new_id);
-				super_node_id[root] = new_id;
-			}
-			else
-			{
-				super_node_id[root] = super_node_id[parent];
-			}
-
-			for (const auto& viz : current_graph[root])
-			{
-				if (viz != parent && super_node_id.count(viz) == 0) { explore_cc(viz, root); }
+				int node = stack.back();
+				stack.pop_back();
+				for (const auto& viz : current_graph[node])
+				{
+					if (super_node_id.count(viz) == 0)
+					{
+						super_node_id[viz] = new_id;
+						stack.push_back(viz);
+					}
+				}
 			}
 			};
 
 		// Calling the explore_cc method for each node that is unexplored
 		for (const auto& id : component_list)
 		{
-			if (super_node_id.count(id) == 0) explore_cc(id, -1);
+			if (super_node_id.count(id) == 0) explore_cc(id);
 		}
 
 		// Connecting each of the nodes of the current step to it's
@@ -453,20 +458,29 @@ verify_general_graph(const vector<tuple<int, int, int, int>>& graph,
 		gg_adj_list[to].push_back(from);
 	}
 
-	function<void(int, int)> compute_cc = [&](int root, int parent) {
-		if (parent == -1) connected_component_id[root] = next_id++;
-		else
-			connected_component_id[root] = connected_component_id[parent];
+	// Iterative, because a tree of the forest can be a path of n nodes.
+	auto compute_cc = [&](int root) {
+		connected_component_id[root] = next_id++;
 
-		for (const auto& viz : gg_adj_list[root])
+		vector<int> stack{ root };
+		while (!stack.empty())
 		{
-			if (connected_component_id[viz] == -1) { compute_cc(viz, root); }
+			int node = stack.back();
+			stack.pop_back();
+			for (const auto& viz : gg_adj_list[node])
+			{
+				if (connected_component_id[viz] == -1)
+				{
+					connected_component_id[viz] = connected_component_id[root];
+					stack.push_back(viz);
+				}
+			}
 		}
 		};
 
 	for (int i = 0; i < n; ++i)
 	{
-		if (connected_component_id[i] == -1) { compute_cc(i, -1); }
+		if (connected_component_id[i] == -1) { compute_cc(i); }
 	}
 
 	vector<vector<int>> connected_components(next_id);
@@ -1,4 +1,8 @@
 #include "Utils/UnionFind.h"
+#include "Utils/PhaseTimer.h"
+#include "Utils/Log.h"
+#include "Utils/WeightTraits.h"
+#include "Utils/MSTResult.h"
 
 #include <vector>
 #include <queue>
@@ -9,76 +13,171 @@
 
 using namespace std;
 
-typedef pair<int, int> branch;
-
 using Clock = std::chrono::steady_clock;
 using ms = std::chrono::duration<double, std::milli>;
 
+// Weight and Index are the types of the weights and the node ids, the common ones are instantiated in Benchmark/EngineInstantiations.cpp
+template<typename Weight = int, typename Index = int>
 class KruskalAlgorithm {
+	typedef pair<Index, Index> branch;
+	using Sum = typename WeightTraits<Weight>::Sum;
+
 public:
-	KruskalAlgorithm(vector<vector<pair<int, int>>>& adjacencyList)
-		: m_adjacencyList(adjacencyList)
-		, m_nodesNumber(adjacencyList.size())
-		, m_unionFind(adjacencyList.size())
+	// an engine kept for many graphs (Utils/MSTEngine.h) calls prepare and solve for each of them
+	KruskalAlgorithm() = default;
+
+	KruskalAlgorithm(WeightedAdjacencyList<Weight, Index>& adjacencyList)
  	{
-		auto start = Clock::now();
-		findMST();
-		auto end = Clock::now();
+		prepare(adjacencyList);
+		solve();
 
-		m_duration = std::chrono::duration_cast<ms>(end - start).count();
+		MST_LOG(Debug, "Kruskal: " << m_mstWeight);
+	}
 
+	// binds the graph, the edge arrays and the union-find keep their memory from the previous graph
+	void prepare(WeightedAdjacencyList<Weight, Index>& adjacencyList) {
+		m_adjacencyList = &adjacencyList;
+		m_nodesNumber = static_cast<Index>(adjacencyList.size());
+		m_numberOfIncludedEdges = 0;
+		m_unionFind.reset(m_nodesNumber);
+		m_branches.clear();
+		m_MST.clear();
+		m_mstWeight = 0;
+		m_phases = {};
+	}
+
+	void solve() {
+		PhaseTimer timer;
+		if constexpr (WeightTraits<Weight>::countingSort) {
+			// the edges are counted and placed by their weights, so the conversion sorts them too
+			collectBranchesByWeight();
+			timer.finish(m_phases.conversion);
+		}
+		else {
+			collectBranches();
+			timer.finish(m_phases.conversion);
+			// sort edges in ascending order
+			sort(m_branches.begin(), m_branches.end());
+			timer.finish(m_phases.preprocessing);
+		}
+		findMST();
+		timer.finish(m_phases.core);
 		printMST();
-		cout << "Kruskal: " << m_mstWeight << endl;
+		timer.finish(m_phases.materialization);
+
+		m_duration = m_phases.total();
 	}
 
 	double getDuration() { return m_duration; }
 
-	size_t getMSTWeight() { return m_mstWeight; }
+	PhaseTimes getPhaseTimes() { return m_phases; }
+
+	// visit(u, v, weight) for each MST edge in the order they were added
+	template<typename Visit>
+	void forEachMSTEdge(Visit visit) {
+		for (const auto& edge : m_MST) {
+			visit(edge.second.first, edge.second.second, edge.first);
+		}
+	}
+
+	// the graph has to be unchanged, the ids are looked up in it
+	MSTResult<Weight, Index> getResult() {
+		vector<MSTEdge<Weight, Index>> edges;
+		forEachMSTEdge([&](Index u, Index v, Weight weight) { edges.push_back({ u, v, weight, noEdgeId }); });
+		assignEdgeIds(*m_adjacencyList, edges);
+		return buildMSTResult(static_cast<size_t>(m_nodesNumber), move(edges));
+	}
+
+	Sum getMSTWeight() { return m_mstWeight; }
 
 private:
-	void sortBranches(vector<pair<int, branch>>& branches) {
+	void collectBranches() {
+		const auto& adjacencyList = *m_adjacencyList;
 		// (i, j) and (j, i) represent the same edge in undirected graph
-		for (int i = 0; i < m_nodesNumber; i++) {
-			for (int j = 0; j < m_adjacencyList[i].size(); j++) {
-				int neighbor = m_adjacencyList[i][j].first;
-				int weight = m_adjacencyList[i][j].second;
+		for (Index i = 0; i < m_nodesNumber; i++) {
+			for (size_t j = 0; j < adjacencyList[i].size(); j++) {
+				Index neighbor = adjacencyList[i][j].first;
+				Weight weight = adjacencyList[i][j].second;
 				if (i < neighbor)
 				{
-					branches.push_back({ weight,{i, neighbor} });
+					m_branches.push_back({ weight,{i, neighbor} });
 				}
 			}
 		}
-		// sort edges in descending order
-		sort(branches.begin(), branches.end());
 	}
 
-	void findMST() {
-		int numberOfIncludedEdges = 0;
+	// counting sort for small weights: only the endpoints are stored, in the order of the weights,
+	// and m_weightEnds[w] is the end of the edges of weight numeric_limits<Weight>::min() + w
+	// only for the small weights, so the explicit instantiations for the wide ones don't have the shift
+	void collectBranchesByWeight() requires (WeightTraits<Weight>::countingSort) {
+		const auto& adjacencyList = *m_adjacencyList;
+		const size_t values = size_t{ 1 } << (8 * sizeof(Weight));
+		m_weightEnds.assign(values, 0);
+
+		for (Index i = 0; i < m_nodesNumber; i++) {
+			for (const auto& [neighbor, weight] : adjacencyList[i]) {
+				if (i < neighbor) m_weightEnds[bucket(weight)]++;
+			}
+		}
 
-		vector<pair<int, pair<int, int>>> branches;
-		sortBranches(branches);
+		// starts of the buckets, they become the ends while the edges are placed
+		size_t start = 0;
+		for (auto& count : m_weightEnds) {
+			size_t edges = count;
+			count = start;
+			start += edges;
+		}
+
+		m_sortedBranches.resize(start);
+		for (Index i = 0; i < m_nodesNumber; i++) {
+			for (const auto& [neighbor, weight] : adjacencyList[i]) {
+				if (i < neighbor) m_sortedBranches[m_weightEnds[bucket(weight)]++] = { i, neighbor };
+			}
+		}
+	}
+
+	static size_t bucket(Weight weight) {
+		return static_cast<size_t>(static_cast<long long>(weight) - static_cast<long long>(numeric_limits<Weight>::min()));
+	}
 
-		// iteration through sorted vector of branches
-		for (auto it = branches.begin(); it != branches.end(); it++) {
+	void findMST() {
+		if constexpr (WeightTraits<Weight>::countingSort) {
+			size_t begin = 0;
+			for (size_t w = 0; w < m_weightEnds.size(); ++w) {
+				const Weight weight = static_cast<Weight>(static_cast<long long>(numeric_limits<Weight>::min()) + static_cast<long long>(w));
+				for (size_t i = begin; i < m_weightEnds[w]; ++i) {
+					if (addBranch(weight, m_sortedBranches[i])) return;
+				}
+				begin = m_weightEnds[w];
+			}
+		}
+		else {
+			// iteration through sorted vector of branches
+			for (auto it = m_branches.begin(); it != m_branches.end(); it++) {
+				if (addBranch(it->first, it->second)) return;
+			}
+		}
+	}
 
-			// stop when |V|-1 edges have been added (the smallest number needed to connect all the nodes and create a MST)
-			if (numberOfIncludedEdges == m_nodesNumber - 1) break;
+	// returns true when the MST is complete
+	bool addBranch(Weight weight, const branch& edge) {
+		// stop when |V|-1 edges have been added (the smallest number needed to connect all the nodes and create a MST)
+		if (m_numberOfIncludedEdges == m_nodesNumber - 1) return true;
 
-			int weight = it->first;
-			int x = it->second.first;
-			int y = it->second.second;
+		Index x = edge.first;
+		Index y = edge.second;
 
-			int fx = m_unionFind.find(x);
-			int fy = m_unionFind.find(y);
+		Index fx = m_unionFind.find(x);
+		Index fy = m_unionFind.find(y);
 
-			// add edge and connect components represented by fx and fy only if they are in different forests
-			if (fx != fy) {
-				m_unionFind.unionOperation(fx, fy);
+		// add edge and connect components represented by fx and fy only if they are in different forests
+		if (fx != fy) {
+			m_unionFind.unionOperation(fx, fy);
 
-				m_MST.push_back({ weight, { x, y } });
-				numberOfIncludedEdges++;
-			}
+			m_MST.push_back({ weight, { x, y } });
+			m_numberOfIncludedEdges++;
 		}
+		return false;
 	}
 
 	void printMST() {
@@ -90,14 +189,22 @@ private:
 	}
 
 private:
-	int m_nodesNumber{0};
+	Index m_nodesNumber{0};
+	Index m_numberOfIncludedEdges{ 0 };
 
-	size_t m_mstWeight{ 0 };
+	Sum m_mstWeight{ 0 };
 	double m_duration{ 0 };
+	PhaseTimes m_phases{};
+
+	// all edges sorted by weight
+	vector<pair<Weight, branch>> m_branches;
+	// the same for small weights: endpoints sorted by weight and the end of each weight
+	vector<branch> m_sortedBranches;
+	vector<size_t> m_weightEnds;
 
-	vector<pair<int, branch>> m_MST;
-	vector<vector<pair<int, int>>>& m_adjacencyList;
+	vector<pair<Weight, branch>> m_MST;
+	WeightedAdjacencyList<Weight, Index>* m_adjacencyList{ nullptr };
 
 	// used for merging different connected componnets
-	UnionFind m_unionFind;
-};
\ No newline at end of file
+	BasicUnionFind<Index> m_unionFind;
+};
@@ -1,72 +1,113 @@
+#include "Utils/PhaseTimer.h"
+#include "Utils/Log.h"
+#include "Utils/WeightTraits.h"
+#include "Utils/GraphAccess.h"
+#include "Utils/MSTResult.h"
+
 #include <vector>
 #include <queue>
 #include <iostream>
+#include <algorithm>
 
 #include <chrono>
 
 using namespace std;
 
-typedef pair<int, int> distanceToTheNode;
-
 using Clock = std::chrono::steady_clock;
 using ms = std::chrono::duration<double, std::milli>;
 
 
+// Weight and Index are the types of the weights and the node ids, the common ones are instantiated in Benchmark/EngineInstantiations.cpp
+// Graph is read through GraphAccess, e.g. the adjacency list or mstgen::CompressedCSR
+template<typename Weight = int, typename Index = int, typename Graph = WeightedAdjacencyList<Weight, Index>>
 class PrimsAlgorithm {
+	typedef pair<Weight, Index> distanceToTheNode;
+	using Sum = typename WeightTraits<Weight>::Sum;
+	using Access = GraphAccess<Graph>;
+
 public:
-	PrimsAlgorithm(vector<vector<pair<int, int>>>& adjacencyList)
-		: m_adjacencyList(adjacencyList)
-		, m_nodesNumber(adjacencyList.size())
-		, m_shortestBranch(adjacencyList.size(), numeric_limits<int>::max())
-		, m_parent(adjacencyList.size(), -1)
-		, m_visited(adjacencyList.size(), false)
+	// an engine kept for many graphs (Utils/MSTEngine.h) calls prepare and solve for each of them
+	PrimsAlgorithm() = default;
+
+	PrimsAlgorithm(Graph& adjacencyList)
 	{
-		auto start = Clock::now();
-		initialize();
-		findMST();
-		auto end = Clock::now();
+		prepare(adjacencyList);
+		solve();
+
+		MST_LOG(Debug, "Prim: " << m_mstWeight);
+	}
 
-		m_duration = std::chrono::duration_cast<ms>(end - start).count();
+	// binds the graph and resets the arrays, their memory is reused when the graph isn't bigger than the previous one
+	void prepare(Graph& adjacencyList) {
+		m_adjacencyList = &adjacencyList;
+		m_nodesNumber = static_cast<Index>(Access::nodesNumber(adjacencyList));
+		// the branches are valid only for the nodes with a parent, so no weight is reserved as "unset"
+		m_shortestBranch.assign(m_nodesNumber, Weight{});
+		m_parent.assign(m_nodesNumber, -1);
+		m_visited.assign(m_nodesNumber, false);
+		m_distances.clear();
+		m_distances.reserve(m_nodesNumber);
+		m_mstWeight = 0;
+		m_phases = {};
+	}
 
+	void solve() {
+		// Prim works directly on the graph, there is no conversion
+		PhaseTimer timer;
+		initialize();
+		timer.finish(m_phases.preprocessing);
+		findMST();
+		timer.finish(m_phases.core);
 		printMST();
-		cout << "Prim: " << m_mstWeight << endl;
+		timer.finish(m_phases.materialization);
+
+		m_duration = m_phases.total();
 	}
 
 	void initialize(){
 
-		int minBranch = numeric_limits<int>::max();
+		Weight minBranch{};
 		m_minBeg = -1;
-		int minEnd = -1;
+		Index minEnd = -1;
 
 		// find the shortest distance in the initial graph
-		for (int i = 0; i < m_adjacencyList.size(); i++) {
-			for (int j = 0; j < m_adjacencyList[i].size(); j++) {
-				if (m_adjacencyList[i][j].second < minBranch) {
-					minBranch = m_adjacencyList[i][j].second;
+		for (Index i = 0; i < m_nodesNumber; i++) {
+			Access::forEachNeighbor(*m_adjacencyList, i, [&](Index neighbor, Weight weight) {
+				if (m_minBeg == -1 || weight < minBranch) {
+					minBranch = weight;
 					m_minBeg = i;
-					minEnd = m_adjacencyList[i][j].first;
+					minEnd = neighbor;
 				}
-			}
+			});
 		}
-		// put it in the priority queue, others will be set to inf
-		m_distances.push(std::make_pair(0, m_minBeg));
-		m_shortestBranch[m_minBeg] = 0;
-		m_parent[m_minBeg] = m_minBeg;
-
-		for (int node = 0; node < m_nodesNumber; node++) {
-			if (node != m_minBeg) {
-				m_distances.push(std::make_pair(std::numeric_limits<int>::max(), node));
-			}
+		// a graph without edges, every node is a tree of its own
+		if (m_minBeg == -1) {
+			if (m_nodesNumber == 0) return;
+			m_minBeg = 0;
 		}
+
+		// put it in the priority queue, the other nodes are pushed when they are reached
+		pushDistance(Weight{}, m_minBeg);
+		m_shortestBranch[m_minBeg] = Weight{};
+		m_parent[m_minBeg] = m_minBeg;
 	}
 
 	void findMST() {
-		for (int i = 0; i < m_nodesNumber; i++) {
+		Index nextRoot = 0;
+		for (Index i = 0; i < m_nodesNumber; i++) {
+			// the tree is finished when the queue is empty, the next unvisited node starts another tree of the forest
+			if (m_distances.empty()) {
+				while (m_visited[nextRoot]) nextRoot++;
+				m_parent[nextRoot] = nextRoot;
+				pushDistance(Weight{}, nextRoot);
+			}
+
 			// current shortest distance is on the top of the priority queue
-			distanceToTheNode closestDistance = m_distances.top();
-			m_distances.pop();
+			pop_heap(m_distances.begin(), m_distances.end(), greater<distanceToTheNode>());
+			distanceToTheNode closestDistance = m_distances.back();
+			m_distances.pop_back();
 
-			int node = closestDistance.second;
+			Index node = closestDistance.second;
 
 			// do not process the node if it's already visited
 			if (m_visited[node]) {
@@ -74,52 +115,74 @@ public:
 				continue;
 			}
 			m_visited[node] = true;
-
 			m_shortestBranch[node] = closestDistance.first;
 
 			// go through all the current node's neighbors that are not already been processed and shorten the path to them if it's possible
-			for (int j = 0; j < m_adjacencyList[node].size(); j++) {
-				if (!m_visited[m_adjacencyList[node][j].first]) {
-					int adjacentNode = m_adjacencyList[node][j].first;
-					int adjacentNodeBranch = m_adjacencyList[node][j].second;
-
-					if (adjacentNodeBranch < m_shortestBranch[adjacentNode]) {
+			// a node without a parent hasn't been reached yet, so any edge reaches it, also one of the largest weight
+			Access::forEachNeighbor(*m_adjacencyList, node, [&](Index adjacentNode, Weight adjacentNodeBranch) {
+				if (!m_visited[adjacentNode]) {
+					if (m_parent[adjacentNode] == -1 || adjacentNodeBranch < m_shortestBranch[adjacentNode]) {
 						m_shortestBranch[adjacentNode] = adjacentNodeBranch;
 						m_parent[adjacentNode] = node;
-						m_distances.push(std::make_pair(adjacentNodeBranch, adjacentNode));
+						pushDistance(adjacentNodeBranch, adjacentNode);
 					}
 				}
-			}
+			});
 		}
 	}
 
+	void pushDistance(Weight distance, Index node) {
+		m_distances.push_back(std::make_pair(distance, node));
+		push_heap(m_distances.begin(), m_distances.end(), greater<distanceToTheNode>());
+	}
+
 	void printMST(){
 
-		for (int i = 0; i < m_nodesNumber; i++) {
-			if (m_minBeg != i) {
-				// std::cout << "(" << m_parent[i] << "," << i << ") distance: " << m_shortestBranch[i] << std::endl;
+		for (Index i = 0; i < m_nodesNumber; i++) {
+			// roots of the trees are their own parents
+			if (m_parent[i] != i) {
 				m_mstWeight += m_shortestBranch[i];
 			}
 		}
 	}
 
-	size_t getMSTWeight() { return m_mstWeight; }
+	Sum getMSTWeight() { return m_mstWeight; }
 
 	double getDuration() { return m_duration; }
 
+	PhaseTimes getPhaseTimes() { return m_phases; }
+
+	// visit(u, v, weight) for each MSF edge, straight from the parent links
+	template<typename Visit>
+	void forEachMSTEdge(Visit visit) {
+		for (Index i = 0; i < m_nodesNumber; i++) {
+			if (m_parent[i] != i) visit(m_parent[i], i, m_shortestBranch[i]);
+		}
+	}
+
+	// the graph has to be unchanged, the ids are looked up in it
+	MSTResult<Weight, Index> getResult() {
+		vector<MSTEdge<Weight, Index>> edges;
+		forEachMSTEdge([&](Index u, Index v, Weight weight) { edges.push_back({ u, v, weight, noEdgeId }); });
+		assignEdgeIds(*m_adjacencyList, edges);
+		return buildMSTResult(static_cast<size_t>(m_nodesNumber), move(edges));
+	}
+
 private:
-	int m_nodesNumber{0};
-	int m_minBeg{-1};
+	Index m_nodesNumber{0};
+	Index m_minBeg{-1};
 
-	size_t m_mstWeight{ 0 };
+	Sum m_mstWeight{ 0 };
 	double m_duration{ 0 };
+	PhaseTimes m_phases{};
 
-	vector<int> m_shortestBranch;
+	vector<Weight> m_shortestBranch;
 	// parent vector has been used to reconstruct MST tree
-	vector<int> m_parent;
+	vector<Index> m_parent;
 	vector<bool> m_visited;
 
-	vector<vector<pair<int, int>>>& m_adjacencyList;
+	Graph* m_adjacencyList{ nullptr };
 
-	priority_queue<distanceToTheNode, vector<distanceToTheNode>, greater<distanceToTheNode>> m_distances;
+	// binary min-heap, a vector instead of priority_queue so it can be cleared and reused for the next graph
+	vector<distanceToTheNode> m_distances;
 };
\ No newline at end of file
@@ -1,3 +1,7 @@
+#include "Utils/PhaseTimer.h"
+#include "Utils/Log.h"
+#include "Utils/MSTResult.h"
+
 #include <vector>
 #include <queue>
 #include <iostream>
@@ -14,42 +18,87 @@ using Clock = std::chrono::steady_clock;
 using ms = std::chrono::duration<double, std::milli>;
 
 class ReverseDeleteAlgorithm {
+	// the edge id is kept because the adjacency list is changed while the edges are deleted
+	struct IndexedBranch {
+		int weight;
+		branch ends;
+		uint64_t id;
+	};
+
 public:
+	// an engine kept for many graphs (Utils/MSTEngine.h) calls prepare and solve for each of them
+	ReverseDeleteAlgorithm() = default;
+
 	ReverseDeleteAlgorithm(vector<vector<pair<int, int>>>& adjacencyList)
-		: m_adjacencyList(adjacencyList)
-		, m_nodesNumber(adjacencyList.size())
 	{
+		prepare(adjacencyList);
+		solve();
 
-		auto start = Clock::now();
-		findMST();
-		auto end = Clock::now();
+		MST_LOG(Debug, "ReverseDelete: " << m_mstWeight);
+	}
 
-		m_duration = std::chrono::duration_cast<ms>(end - start).count();
-		
+	// binds the graph, which is changed by solve, the edge arrays and the search buffers keep their memory
+	void prepare(vector<vector<pair<int, int>>>& adjacencyList) {
+		m_adjacencyList = &adjacencyList;
+		m_nodesNumber = adjacencyList.size();
+		m_branches.clear();
+		m_MST.clear();
+		m_mstWeight = 0;
+		m_phases = {};
+	}
+
+	void solve() {
+		PhaseTimer timer;
+		collectBranches();
+		timer.finish(m_phases.conversion);
+		// sort edges in descending order
+		sort(m_branches.begin(), m_branches.end(),
+			[](const IndexedBranch& a, const IndexedBranch& b) { return a.weight > b.weight; });
+		timer.finish(m_phases.preprocessing);
+		findMST();
+		timer.finish(m_phases.core);
 		printMST();
-		cout << "ReverseDelete: " << m_mstWeight << endl;
+		timer.finish(m_phases.materialization);
+
+		m_duration = m_phases.total();
 	}
 
 	size_t getMSTWeight() { return m_mstWeight; }
 
 	double getDuration() { return m_duration; }
 
+	PhaseTimes getPhaseTimes() { return m_phases; }
+
+	// visit(u, v, weight) for each MST edge in the order they were kept
+	template<typename Visit>
+	void forEachMSTEdge(Visit visit) {
+		for (const auto& edge : m_MST) {
+			visit(edge.u, edge.v, edge.weight);
+		}
+	}
+
+	MSTResult<> getResult() {
+		return buildMSTResult(static_cast<size_t>(m_nodesNumber), m_MST);
+	}
+
 private:
 	// Depth First Search algorithm
 	void dfs(int node, vector<bool>& visited) {
 
 		visited[node] = true;
 
-		for (auto n : m_adjacencyList[node]) {
+		for (auto n : (*m_adjacencyList)[node]) {
 			if (!visited[n.first]) {
 				dfs(n.first, visited);
 			}
 		}
 	}
 
-	void dfsIterative(int node, std::vector<bool>& visited) {
+	// returns true as soon as the target is reached
+	bool dfsIterative(int node, int target, std::vector<bool>& visited) {
 
-		std::vector<int> stack;
+		std::vector<int>& stack = m_stack;
+		stack.clear();
 
 		stack.push_back(node);
 		visited[node] = true;
@@ -57,8 +106,9 @@ private:
 		while (!stack.empty()) {
 			int u = stack.back();
 			stack.pop_back();
+			if (u == target) return true;
 
-			for (const auto& neighbor : m_adjacencyList[u]) {
+			for (const auto& neighbor : (*m_adjacencyList)[u]) {
 				int v = neighbor.first;
 				if (!visited[v]) {
 					visited[v] = 1;
@@ -66,67 +116,57 @@ private:
 				}
 			}
 		}
+		return false;
 	}
 
-	bool isGraphConnected() {
-		// when all nodes are connected, there is only one component and graph is connected
-		vector<bool> visited(m_nodesNumber, false);
-		// dfs(0, visited);
-		dfsIterative(0, visited);
-
-		for (auto node : visited) {
-			if (!node) {
-				return false;
-			}
-		}
-		return true;
+	bool areConnected(int u, int v) {
+		// the components stay the same after the removal of (u, v) only if v is still reachable from u,
+		// so the graph doesn't have to be connected and the result is a minimum spanning forest
+		m_visited.assign(m_nodesNumber, false);
+		// dfs(u, m_visited); return m_visited[v];
+		return dfsIterative(u, v, m_visited);
 	}
 
-	void sortBranches(vector<pair<int, branch>>& branches) {
+	void collectBranches() {
+		const auto& adjacencyList = *m_adjacencyList;
 
 		for (int i = 0; i < m_nodesNumber; i++) {
-			for (int j = 0; j < m_adjacencyList[i].size(); j++) {
-				int neighbor = m_adjacencyList[i][j].first;
-				int weight = m_adjacencyList[i][j].second;
+			for (int j = 0; j < adjacencyList[i].size(); j++) {
+				int neighbor = adjacencyList[i][j].first;
+				int weight = adjacencyList[i][j].second;
 				if (i < neighbor)
 				{
-					branches.push_back({ weight,{i, neighbor} });
+					m_branches.push_back({ weight, {i, neighbor}, m_branches.size() });
 				}
 			}
 		}
-		// sort edges in ascending order
-		sort(branches.begin(), branches.end(),
-			[](const pair<int, branch>& a, const pair<int, branch>& b) { return a.first > b.first; });
 	}
 
 	void findMST() {
-		
-		vector<pair<int, branch>> branches;
-		sortBranches(branches);
-
+		auto& adjacencyList = *m_adjacencyList;
 		// takes one by one edge from sorted vector
-		for (auto currentBranch : branches){
+		for (auto currentBranch : m_branches){
 
-			int u = currentBranch.second.first;
-			int v = currentBranch.second.second;
-			int weight = currentBranch.first;
+			int u = currentBranch.ends.first;
+			int v = currentBranch.ends.second;
+			int weight = currentBranch.weight;
 
 			// try to remove it
-			m_adjacencyList[u].erase(remove_if(m_adjacencyList[u].begin(), m_adjacencyList[u].end(),
+			adjacencyList[u].erase(remove_if(adjacencyList[u].begin(), adjacencyList[u].end(),
 				[v](const branch& b) {
 					return b.first == v ;
-				}), m_adjacencyList[u].end());
-			m_adjacencyList[v].erase(remove_if(m_adjacencyList[v].begin(), m_adjacencyList[v].end(),
+				}), adjacencyList[u].end());
+			adjacencyList[v].erase(remove_if(adjacencyList[v].begin(), adjacencyList[v].end(),
 				[u](const branch& b) {
 					return b.first == u;
-				}), m_adjacencyList[v].end());
+				}), adjacencyList[v].end());
 
-			// if graph remains connected it's valid, if not push the branch back to adjacency list
-			if (isGraphConnected() == false){
-				m_adjacencyList[u].push_back({v, weight});
-				m_adjacencyList[v].push_back({u, weight});
+			// if its endpoints remain connected it's valid, if not push the branch back to adjacency list
+			if (areConnected(u, v) == false){
+				adjacencyList[u].push_back({v, weight});
+				adjacencyList[v].push_back({u, weight});
 
-				m_MST.push_back({ weight, {u, v} });
+				m_MST.push_back({ u, v, weight, currentBranch.id });
 			}
 		}
 
@@ -135,8 +175,8 @@ private:
 	void printMST() {
 
 		for (auto it = m_MST.begin(); it != m_MST.end(); it++) {
-			// cout << "(" << it->second.first << ", " << it->second.second << ") weight: " << it->first << endl;
-			m_mstWeight += it->first;
+			// cout << "(" << it->u << ", " << it->v << ") weight: " << it->weight << endl;
+			m_mstWeight += it->weight;
 		}
 	}
 
@@ -145,7 +185,14 @@ private:
 
 	size_t m_mstWeight{ 0 };
 	double m_duration{ 0 };
+	PhaseTimes m_phases{};
+
+	// all edges sorted by weight in descending order
+	vector<IndexedBranch> m_branches;
+	vector<MSTEdge<>> m_MST;
+	vector<vector<pair<int, int>>>* m_adjacencyList{ nullptr };
 
-	vector<pair<int, branch>> m_MST;
-	vector<vector<pair<int, int>>>& m_adjacencyList;
+	// buffers of the connectivity checks, one check per edge
+	vector<bool> m_visited;
+	vector<int> m_stack;
 };
\ No newline at end of file
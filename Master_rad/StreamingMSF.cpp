@@ -0,0 +1,157 @@
+#include "Utils/UnionFind.h"
+#include "Utils/PhaseTimer.h"
+#include "Utils/Log.h"
+#include "Utils/WeightTraits.h"
+#include "Utils/MSTResult.h"
+#include "Utils/ParallelSort.h"
+#include "Karger/Verifier.hpp"
+#include "GraphIO/EdgeStream.hpp"
+
+#include <vector>
+#include <tuple>
+#include <iostream>
+#include <algorithm>
+#include <string>
+#include <cstdint>
+#include <unordered_set>
+
+using namespace std;
+
+struct StreamingMSFOptions {
+	// memory for a batch, the verifier needs about batchBytesPerEdge bytes for every edge of the batch and of the forest
+	size_t memoryBytes{ size_t{ 1 } << 30 };
+	size_t batchBytesPerEdge{ 128 };
+};
+
+// semi-streaming minimum spanning forest: the edges are read in batches and only the current forest F is kept
+// the F-heavy edges of each batch (heavier than the heaviest edge of the F path between their endpoints,
+// found by the linear time verifier of Karger) can't be in the MSF and are discarded,
+// and the MSF of F and the remaining edges of the batch becomes the new F
+// memory is O(n + batch) and the file is read once, the result is exact
+class StreamingMSFAlgorithm {
+	// the weights of the streams are int and can be negative
+	using Sum = WeightTraits<int>::Sum;
+
+public:
+	StreamingMSFAlgorithm(const string& path, StreamingMSFOptions options = {})
+		: m_options(options)
+		, m_reader(path)
+	{
+		const size_t batchEdges = max<size_t>(1, m_options.memoryBytes / m_options.batchBytesPerEdge);
+
+		PhaseTimer timer;
+		vector<mstio::StreamEdge> batch;
+		while (true) {
+			bool more = m_reader.read(batch, batchEdges);
+			timer.finish(m_phases.conversion);
+			if (!more) break;
+
+			m_edgesNumber += batch.size();
+			filterHeavyEdges(batch);
+			timer.finish(m_phases.preprocessing);
+
+			updateForest(batch);
+			timer.finish(m_phases.core);
+		}
+
+		for (const auto& edge : m_forest) {
+			m_mstWeight += edge.weight;
+		}
+		timer.finish(m_phases.materialization);
+
+		m_duration = m_phases.total();
+
+		MST_LOG(Debug, "StreamingMSF: " << m_mstWeight);
+	}
+
+	double getDuration() { return m_duration; }
+
+	PhaseTimes getPhaseTimes() { return m_phases; }
+
+	Sum getMSTWeight() { return m_mstWeight; }
+
+	size_t getForestEdgesNumber() { return m_forest.size(); }
+
+	size_t getNodesNumber() { return m_reader.nodesNumber(); }
+
+	// visit(u, v, weight) for each forest edge
+	template<typename Visit>
+	void forEachMSTEdge(Visit visit) {
+		for (const auto& edge : m_forest) {
+			visit(edge.u, edge.v, edge.weight);
+		}
+	}
+
+	// the edges come from a stream, their ids are noEdgeId
+	MSTResult<> getResult() {
+		vector<MSTEdge<>> edges;
+		edges.reserve(m_forest.size());
+		forEachMSTEdge([&](int u, int v, int weight) { edges.push_back({ u, v, weight, noEdgeId }); });
+		return buildMSTResult(getNodesNumber(), move(edges));
+	}
+
+	// number of edges discarded as F-heavy before they reached the forest computation
+	size_t getHeavyEdgesNumber() { return m_heavyEdgesNumber; }
+
+	size_t getEdgesNumber() { return m_edgesNumber; }
+
+private:
+	// removes the loops and the edges that are F-heavy for the current forest
+	void filterHeavyEdges(vector<mstio::StreamEdge>& batch) {
+		batch.erase(remove_if(batch.begin(), batch.end(), [](const mstio::StreamEdge& edge) { return edge.u == edge.v; }), batch.end());
+		if (m_forest.empty() || batch.empty()) return;
+
+		// edges follow the convention of the verifier (from, to, cost, id), the id of a batch edge is its index
+		vector<tuple<int, int, int, int>> graph;
+		graph.reserve(batch.size());
+		for (size_t i = 0; i < batch.size(); ++i) {
+			graph.emplace_back(batch[i].u, batch[i].v, batch[i].weight, static_cast<int>(i));
+		}
+
+		vector<tuple<int, int, int, int>> forest;
+		forest.reserve(m_forest.size());
+		for (size_t i = 0; i < m_forest.size(); ++i) {
+			forest.emplace_back(m_forest[i].u, m_forest[i].v, m_forest[i].weight, static_cast<int>(batch.size() + i));
+		}
+
+		unordered_set<int> heavyEdges = verify_general_graph(graph, forest, static_cast<int>(m_reader.nodesNumber()));
+		m_heavyEdgesNumber += heavyEdges.size();
+
+		size_t light = 0;
+		for (size_t i = 0; i < batch.size(); ++i) {
+			if (heavyEdges.find(static_cast<int>(i)) == heavyEdges.end()) batch[light++] = batch[i];
+		}
+		batch.resize(light);
+	}
+
+	// Kruskal on the forest and the light edges of the batch
+	void updateForest(vector<mstio::StreamEdge>& batch) {
+		batch.insert(batch.end(), m_forest.begin(), m_forest.end());
+		// the sign bit is flipped, so negative weights come first
+		parallelRadixSort(batch, [](const mstio::StreamEdge& edge) { return static_cast<uint64_t>(static_cast<uint32_t>(edge.weight) ^ 0x80000000u); });
+
+		UnionFind unionFind(static_cast<int>(m_reader.nodesNumber()));
+		m_forest.clear();
+		for (const auto& edge : batch) {
+			int fx = unionFind.find(edge.u);
+			int fy = unionFind.find(edge.v);
+			if (fx != fy) {
+				unionFind.unionOperation(fx, fy);
+				m_forest.push_back(edge);
+			}
+		}
+	}
+
+private:
+	StreamingMSFOptions m_options;
+	mstio::EdgeStreamReader m_reader;
+
+	Sum m_mstWeight{ 0 };
+	double m_duration{ 0 };
+	PhaseTimes m_phases{};
+
+	// current minimum spanning forest of the edges read so far
+	vector<mstio::StreamEdge> m_forest;
+	size_t m_heavyEdgesNumber{ 0 };
+	size_t m_edgesNumber{ 0 };
+};
@@ -1,5 +1,6 @@
 #include <limits>
 #include <utility>
+#include <vector>
 
 #include <boost/heap/fibonacci_heap.hpp>
 #include <boost/heap/d_ary_heap.hpp>
@@ -24,4 +25,48 @@ struct comparator
 // fibonacci heap is used to store pairs of node IDs and its cheapest edge
 typedef boost::heap::fibonacci_heap< pair<int, int>, boost::heap::compare< comparator>, boost::heap::mutable_<true>> fibonacciHeap;
 // reference to the each element 
-typedef boost::heap::fibonacci_heap< pair<int, int>, boost::heap::compare< comparator>, boost::heap::mutable_<true>>::handle_type fibonacciHeapHandle;
\ No newline at end of file
+typedef boost::heap::fibonacci_heap< pair<int, int>, boost::heap::compare< comparator>, boost::heap::mutable_<true>>::handle_type fibonacciHeapHandle;
+
+// fibonacci heap with the interface of the heaps from IndexedHeap.h, so it can be compared with them (e.g. FredmanTarjan<FibonacciHeap>)
+class FibonacciHeap
+{
+public:
+	explicit FibonacciHeap(int capacity = 0) { reset(capacity); }
+
+	void reset(int capacity) {
+		m_heap.clear();
+		m_handles.assign(capacity, fibonacciHeapHandle{});
+		m_inHeap.assign(capacity, false);
+	}
+
+	bool empty() const { return m_heap.empty(); }
+	size_t size() const { return m_heap.size(); }
+	bool contains(int id) const { return m_inHeap[id]; }
+	int getKey(int id) const { return (*m_handles[id]).second; }
+
+	pair<int, int> top() const { return m_heap.top(); }
+
+	void push(int id, int key) {
+		m_handles[id] = m_heap.emplace(id, key);
+		m_inHeap[id] = true;
+	}
+
+	void decreaseKey(int id, int key) { m_heap.increase(m_handles[id], make_pair(id, key)); }
+
+	void pop() {
+		m_inHeap[m_heap.top().first] = false;
+		m_heap.pop();
+	}
+
+	void clear() {
+		for (const auto& element : m_heap) {
+			m_inHeap[element.first] = false;
+		}
+		m_heap.clear();
+	}
+
+private:
+	fibonacciHeap m_heap;
+	vector<fibonacciHeapHandle> m_handles;
+	vector<bool> m_inHeap;
+};
\ No newline at end of file
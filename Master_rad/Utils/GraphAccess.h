@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// how Prim and Boruvka read their graph: the number of nodes and the (neighbor, weight) pairs of a node
+// the adjacency list is built in, other representations (e.g. mstgen::CompressedCSR) specialize GraphAccess
+template<typename Graph>
+struct GraphAccess;
+
+template<typename Index, typename Weight>
+struct GraphAccess<vector<vector<pair<Index, Weight>>>>
+{
+	using Graph = vector<vector<pair<Index, Weight>>>;
+
+	static size_t nodesNumber(const Graph& graph) { return graph.size(); }
+
+	// visit(neighbor, weight) for each neighbor of the node
+	template<typename Visit>
+	static void forEachNeighbor(const Graph& graph, size_t node, Visit visit)
+	{
+		for (const auto& [neighbor, weight] : graph[node]) {
+			visit(neighbor, weight);
+		}
+	}
+};
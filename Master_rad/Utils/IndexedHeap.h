@@ -0,0 +1,414 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// Addressable min heaps over dense ids 0..capacity-1 (vertex ids of a graph).
+// Instead of node handles every heap keeps arrays indexed by id, so no memory is allocated per element.
+// All of them have the same interface, they are used as a template parameter (e.g. FredmanTarjan):
+//   push(id, key), decreaseKey(id, key), top() -> (id, key), pop(), contains(id), getKey(id),
+//   size(), empty(), clear() - removes remaining elements in O(number of elements),
+//   reset(capacity) - prepares the heap for different number of ids
+
+// d-ary heap stored in an array, position of each id is kept for decreaseKey
+template<unsigned D = 4>
+class DaryHeap
+{
+public:
+	explicit DaryHeap(int capacity = 0) { reset(capacity); }
+
+	void reset(int capacity) {
+		m_heap.clear();
+		m_position.assign(capacity, -1);
+		m_key.assign(capacity, 0);
+	}
+
+	bool empty() const { return m_heap.empty(); }
+	size_t size() const { return m_heap.size(); }
+	bool contains(int id) const { return m_position[id] != -1; }
+	int getKey(int id) const { return m_key[id]; }
+
+	pair<int, int> top() const { return { m_heap.front(), m_key[m_heap.front()] }; }
+
+	void push(int id, int key) {
+		m_key[id] = key;
+		m_position[id] = static_cast<int>(m_heap.size());
+		m_heap.push_back(id);
+		siftUp(m_position[id]);
+	}
+
+	void decreaseKey(int id, int key) {
+		m_key[id] = key;
+		siftUp(m_position[id]);
+	}
+
+	void pop() {
+		int last = m_heap.back();
+		m_position[m_heap.front()] = -1;
+		m_heap.pop_back();
+
+		if (!m_heap.empty()) {
+			m_heap[0] = last;
+			m_position[last] = 0;
+			siftDown(0);
+		}
+	}
+
+	void clear() {
+		for (int id : m_heap) {
+			m_position[id] = -1;
+		}
+		m_heap.clear();
+	}
+
+private:
+	void place(int index, int id) {
+		m_heap[index] = id;
+		m_position[id] = index;
+	}
+
+	void siftUp(int index) {
+		int id = m_heap[index];
+		while (index > 0) {
+			int parent = (index - 1) / D;
+			if (m_key[m_heap[parent]] <= m_key[id]) break;
+			place(index, m_heap[parent]);
+			index = parent;
+		}
+		place(index, id);
+	}
+
+	void siftDown(int index) {
+		int id = m_heap[index];
+		int n = static_cast<int>(m_heap.size());
+
+		while (true) {
+			int first = index * D + 1;
+			if (first >= n) break;
+
+			// the smallest of at most D children
+			int best = first;
+			int last = min(n, first + static_cast<int>(D));
+			for (int child = first + 1; child < last; ++child) {
+				if (m_key[m_heap[child]] < m_key[m_heap[best]]) best = child;
+			}
+
+			if (m_key[m_heap[best]] >= m_key[id]) break;
+			place(index, m_heap[best]);
+			index = best;
+		}
+		place(index, id);
+	}
+
+private:
+	vector<int> m_heap;
+	// index in m_heap, -1 if id is not in the heap
+	vector<int> m_position;
+	vector<int> m_key;
+};
+
+// pairing heap, nodes are the ids themselves (child, sibling and previous are ids too)
+class PairingHeap
+{
+public:
+	explicit PairingHeap(int capacity = 0) { reset(capacity); }
+
+	void reset(int capacity) {
+		m_nodes.assign(capacity, Node{});
+		m_inserted.clear();
+		m_root = -1;
+		m_size = 0;
+	}
+
+	bool empty() const { return m_root == -1; }
+	size_t size() const { return m_size; }
+	bool contains(int id) const { return m_nodes[id].inHeap; }
+	int getKey(int id) const { return m_nodes[id].key; }
+
+	pair<int, int> top() const { return { m_root, m_nodes[m_root].key }; }
+
+	void push(int id, int key) {
+		Node& node = m_nodes[id];
+		node = Node{};
+		node.key = key;
+		node.inHeap = true;
+
+		m_inserted.push_back(id);
+		m_root = m_root == -1 ? id : link(m_root, id);
+		m_size++;
+	}
+
+	void decreaseKey(int id, int key) {
+		m_nodes[id].key = key;
+		if (id == m_root) return;
+
+		// cut the subtree of id and link it with the root
+		cut(id);
+		m_root = link(m_root, id);
+	}
+
+	void pop() {
+		int root = m_root;
+		m_nodes[root].inHeap = false;
+		m_root = combineSiblings(m_nodes[root].child);
+		m_size--;
+	}
+
+	void clear() {
+		for (int id : m_inserted) {
+			m_nodes[id].inHeap = false;
+		}
+		m_inserted.clear();
+		m_root = -1;
+		m_size = 0;
+	}
+
+private:
+	struct Node {
+		int key{ 0 };
+		int child{ -1 };
+		int sibling{ -1 };
+		// parent for the first child, previous sibling for others
+		int prev{ -1 };
+		bool inHeap{ false };
+	};
+
+	// makes the root with the bigger key the first child of the other one, returns the new root
+	int link(int a, int b) {
+		if (m_nodes[b].key < m_nodes[a].key) swap(a, b);
+
+		Node& parent = m_nodes[a];
+		Node& child = m_nodes[b];
+
+		child.sibling = parent.child;
+		child.prev = a;
+		if (parent.child != -1) m_nodes[parent.child].prev = b;
+		parent.child = b;
+
+		parent.sibling = -1;
+		parent.prev = -1;
+		return a;
+	}
+
+	void cut(int id) {
+		Node& node = m_nodes[id];
+		Node& prev = m_nodes[node.prev];
+
+		if (prev.child == id) prev.child = node.sibling;
+		else prev.sibling = node.sibling;
+
+		if (node.sibling != -1) m_nodes[node.sibling].prev = node.prev;
+
+		node.sibling = -1;
+		node.prev = -1;
+	}
+
+	// two pass pairing of the children list
+	int combineSiblings(int first) {
+		if (first == -1) return -1;
+
+		m_pairs.clear();
+
+		// first pass: link pairs from left to right
+		int current = first;
+		while (current != -1) {
+			int second = m_nodes[current].sibling;
+			int next = second != -1 ? m_nodes[second].sibling : -1;
+
+			m_nodes[current].sibling = m_nodes[current].prev = -1;
+			if (second != -1) {
+				m_nodes[second].sibling = m_nodes[second].prev = -1;
+				current = link(current, second);
+			}
+			m_pairs.push_back(current);
+			current = next;
+		}
+
+		// second pass: link from right to left
+		int root = m_pairs.back();
+		for (int i = static_cast<int>(m_pairs.size()) - 2; i >= 0; --i) {
+			root = link(m_pairs[i], root);
+		}
+		return root;
+	}
+
+private:
+	vector<Node> m_nodes;
+	// ids pushed since the last clear
+	vector<int> m_inserted;
+	vector<int> m_pairs;
+	int m_root{ -1 };
+	size_t m_size{ 0 };
+};
+
+// rank-pairing heap (type 1) by Haeupler, Sen and Tarjan
+// heap is a list of half-ordered binary trees: key of each node is smaller than keys in its left subtree
+class RankPairingHeap
+{
+public:
+	explicit RankPairingHeap(int capacity = 0) { reset(capacity); }
+
+	void reset(int capacity) {
+		m_nodes.assign(capacity, Node{});
+		m_roots.clear();
+		m_inserted.clear();
+		m_min = -1;
+		m_size = 0;
+	}
+
+	bool empty() const { return m_size == 0; }
+	size_t size() const { return m_size; }
+	bool contains(int id) const { return m_nodes[id].inHeap; }
+	int getKey(int id) const { return m_nodes[id].key; }
+
+	pair<int, int> top() const { return { m_min, m_nodes[m_min].key }; }
+
+	void push(int id, int key) {
+		Node& node = m_nodes[id];
+		node = Node{};
+		node.key = key;
+		node.inHeap = true;
+
+		m_inserted.push_back(id);
+		addRoot(id);
+		m_size++;
+	}
+
+	void decreaseKey(int id, int key) {
+		Node& node = m_nodes[id];
+		node.key = key;
+
+		if (node.parent == -1) {
+			if (key < m_nodes[m_min].key) m_min = id;
+			return;
+		}
+
+		// right subtree takes the place of the node, the node with its left subtree becomes a new root
+		int parent = node.parent;
+		int right = node.right;
+
+		if (m_nodes[parent].left == id) m_nodes[parent].left = right;
+		else m_nodes[parent].right = right;
+		if (right != -1) m_nodes[right].parent = parent;
+
+		node.right = -1;
+		node.parent = -1;
+		node.rank = node.left != -1 ? m_nodes[node.left].rank + 1 : 0;
+		addRoot(id);
+
+		// ranks on the path to the root can only decrease
+		for (int u = parent; u != -1; u = m_nodes[u].parent) {
+			int newRank = m_nodes[u].parent == -1 ? rankOf(m_nodes[u].left) + 1 : typeOneRank(u);
+			if (newRank >= m_nodes[u].rank) break;
+			m_nodes[u].rank = newRank;
+		}
+	}
+
+	void pop() {
+		int min = m_min;
+		Node& minNode = m_nodes[min];
+		minNode.inHeap = false;
+		m_size--;
+
+		m_candidates.clear();
+		for (int root : m_roots) {
+			if (root != min) m_candidates.push_back(root);
+		}
+
+		// right spine of the left child becomes a list of new roots
+		for (int u = minNode.left; u != -1;) {
+			int next = m_nodes[u].right;
+			m_nodes[u].right = -1;
+			m_nodes[u].parent = -1;
+			m_nodes[u].rank = rankOf(m_nodes[u].left) + 1;
+			m_candidates.push_back(u);
+			u = next;
+		}
+
+		// one pass of linking roots with equal ranks
+		m_roots.clear();
+		m_min = -1;
+		for (int root : m_candidates) {
+			int rank = m_nodes[root].rank;
+			if (rank >= static_cast<int>(m_buckets.size())) m_buckets.resize(rank + 1, -1);
+
+			if (m_buckets[rank] == -1) {
+				m_buckets[rank] = root;
+			}
+			else {
+				int other = m_buckets[rank];
+				m_buckets[rank] = -1;
+				addRoot(link(root, other));
+			}
+		}
+		for (int root : m_candidates) {
+			int rank = m_nodes[root].rank;
+			if (rank < static_cast<int>(m_buckets.size()) && m_buckets[rank] == root) {
+				m_buckets[rank] = -1;
+				addRoot(root);
+			}
+		}
+	}
+
+	void clear() {
+		for (int id : m_inserted) {
+			m_nodes[id].inHeap = false;
+		}
+		m_inserted.clear();
+		m_roots.clear();
+		m_min = -1;
+		m_size = 0;
+	}
+
+private:
+	struct Node {
+		int key{ 0 };
+		int rank{ 0 };
+		int left{ -1 };
+		int right{ -1 };
+		int parent{ -1 };
+		bool inHeap{ false };
+	};
+
+	int rankOf(int id) const { return id == -1 ? -1 : m_nodes[id].rank; }
+
+	// rank rule for the non-root nodes
+	int typeOneRank(int id) const {
+		int a = rankOf(m_nodes[id].left);
+		int b = rankOf(m_nodes[id].right);
+		return abs(a - b) > 1 ? max(a, b) : max(a, b) + 1;
+	}
+
+	void addRoot(int id) {
+		m_roots.push_back(id);
+		if (m_min == -1 || m_nodes[id].key < m_nodes[m_min].key) m_min = id;
+	}
+
+	// two roots of the same rank, the one with the bigger key becomes the left child of the other one
+	int link(int a, int b) {
+		if (m_nodes[b].key < m_nodes[a].key) swap(a, b);
+
+		Node& winner = m_nodes[a];
+		Node& loser = m_nodes[b];
+
+		loser.right = winner.left;
+		if (winner.left != -1) m_nodes[winner.left].parent = b;
+		loser.parent = a;
+		winner.left = b;
+		winner.rank = loser.rank + 1;
+		return a;
+	}
+
+private:
+	vector<Node> m_nodes;
+	vector<int> m_roots;
+	vector<int> m_candidates;
+	vector<int> m_buckets;
+	vector<int> m_inserted;
+	int m_min{ -1 };
+	size_t m_size{ 0 };
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <array>
+#include <iostream>
+
+using namespace std;
+
+// leveled logging of the engines and the benchmark, the engines and the graph diagnostics log only at the debug level
+// MST_LOG_LEVEL removes the levels above it at compile time (e.g. -DMST_LOG_LEVEL=2 keeps only errors and warnings),
+// the level of a run is chosen at run time with setLogLevel (--log-level), info by default
+// the message of MST_LOG is evaluated only when it's written, so expensive diagnostics (density, connectivity) cost nothing otherwise
+
+#ifndef MST_LOG_LEVEL
+#define MST_LOG_LEVEL 4
+#endif
+
+enum class LogLevel
+{
+	None = 0,
+	Error = 1,
+	Warning = 2,
+	Info = 3,
+	Debug = 4
+};
+
+inline const array<LogLevel, 5>& logLevels()
+{
+	static const array<LogLevel, 5> levels{ LogLevel::None, LogLevel::Error, LogLevel::Warning, LogLevel::Info, LogLevel::Debug };
+	return levels;
+}
+
+inline const char* logLevelName(LogLevel level)
+{
+	switch (level) {
+	case LogLevel::None: return "none";
+	case LogLevel::Error: return "error";
+	case LogLevel::Warning: return "warning";
+	case LogLevel::Info: return "info";
+	default: return "debug";
+	}
+}
+
+inline LogLevel& currentLogLevel()
+{
+	static LogLevel level = LogLevel::Info;
+	return level;
+}
+
+inline void setLogLevel(LogLevel level) { currentLogLevel() = level; }
+
+inline bool logEnabled(LogLevel level)
+{
+	return static_cast<int>(level) <= MST_LOG_LEVEL && static_cast<int>(level) <= static_cast<int>(currentLogLevel());
+}
+
+// errors and warnings go to stderr, so they don't mix with the output of the modes
+inline ostream& logStream(LogLevel level) { return level <= LogLevel::Warning ? cerr : cout; }
+
+// MST_LOG(Info, "n=" << n) - the level is the name of a LogLevel
+#define MST_LOG(level, message) \
+	do { \
+		if constexpr (static_cast<int>(LogLevel::level) <= MST_LOG_LEVEL) { \
+			if (logEnabled(LogLevel::level)) logStream(LogLevel::level) << message << '\n'; \
+		} \
+	} while (false)
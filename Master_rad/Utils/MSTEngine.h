@@ -0,0 +1,69 @@
+#pragma once
+
+#include "PhaseTimer.h"
+#include "MSTResult.h"
+#include "WeightTraits.h"
+
+#include <utility>
+
+using namespace std;
+
+// common interface of the MST engines for callers that keep an engine and solve many graphs with it
+// prepare binds the graph and resets the workspaces (their memory stays from the previous graphs),
+// solve runs the algorithm and writes nothing, result gives the forest of the last solve
+// the graph has to stay alive and unchanged until the result is read, Reverse-Delete changes it during solve
+class MSTEngine
+{
+public:
+	virtual ~MSTEngine() = default;
+
+	virtual void prepare(WeightedAdjacencyList<>& graph) = 0;
+	virtual void solve() = 0;
+	// built on the first call after solve, outside of the measured phases
+	virtual const MSTResult<>& result() = 0;
+
+	virtual double weight() = 0;
+	virtual PhaseTimes phases() = 0;
+};
+
+// MSTEngine for the engine classes, which all have prepare, solve, getResult, getMSTWeight and getPhaseTimes
+template<typename Algorithm>
+class AlgorithmEngine : public MSTEngine
+{
+public:
+	// arguments go to the constructor of the algorithm, e.g. ChazelleOptions
+	template<typename... Args>
+	explicit AlgorithmEngine(Args&&... args) : m_algorithm(forward<Args>(args)...) {}
+
+	void prepare(WeightedAdjacencyList<>& graph) override
+	{
+		m_algorithm.prepare(graph);
+		m_resultReady = false;
+	}
+
+	void solve() override
+	{
+		m_algorithm.solve();
+		m_resultReady = false;
+	}
+
+	const MSTResult<>& result() override
+	{
+		if (!m_resultReady) {
+			m_result = m_algorithm.getResult();
+			m_resultReady = true;
+		}
+		return m_result;
+	}
+
+	double weight() override { return static_cast<double>(m_algorithm.getMSTWeight()); }
+
+	PhaseTimes phases() override { return m_algorithm.getPhaseTimes(); }
+
+	Algorithm& algorithm() { return m_algorithm; }
+
+private:
+	Algorithm m_algorithm;
+	MSTResult<> m_result;
+	bool m_resultReady{ false };
+};
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "WeightTraits.h"
+#include "GraphAccess.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// edge of a minimum spanning forest
+// id is the index of the edge among the entries (u, v) with u < v of the adjacency list, in the order of the list
+// (node by node, each list in its order), the numbering used by Fredman-Tarjan, Karger and Chazelle
+template<typename Weight = int, typename Index = int>
+struct MSTEdge
+{
+	Index u;
+	Index v;
+	Weight weight;
+	uint64_t id;
+};
+
+// no id, e.g. for the streaming engines which don't keep the position of the edges
+constexpr uint64_t noEdgeId = ~uint64_t{ 0 };
+
+// result of every engine: the edges of the minimum spanning forest and the forest as parent links
+template<typename Weight = int, typename Index = int>
+struct MSTResult
+{
+	vector<MSTEdge<Weight, Index>> edges;
+	// parent of each node, -1 for the roots, which are the smallest nodes of their trees
+	vector<Index> parent;
+	typename WeightTraits<Weight>::Sum totalWeight{ 0 };
+	// trees of the forest, 1 for a connected graph (isolated nodes are trees too)
+	size_t componentsNumber{ 0 };
+	// tree of each node, the trees are numbered in the order of their roots, and the weight of each tree
+	vector<Index> component;
+	vector<typename WeightTraits<Weight>::Sum> componentWeights;
+};
+
+// builds the parent links and the sums of the forest edges, edges are kept in the order of the engine
+template<typename Weight, typename Index>
+MSTResult<Weight, Index> buildMSTResult(size_t nodesNumber, vector<MSTEdge<Weight, Index>> edges)
+{
+	MSTResult<Weight, Index> result;
+	result.edges = move(edges);
+
+	// forest as CSR
+	vector<size_t> first(nodesNumber + 1, 0);
+	for (const auto& edge : result.edges) {
+		result.totalWeight += edge.weight;
+		first[edge.u + 1]++;
+		first[edge.v + 1]++;
+	}
+	for (size_t node = 0; node < nodesNumber; ++node) {
+		first[node + 1] += first[node];
+	}
+	vector<Index> neighbors(first[nodesNumber]);
+	vector<size_t> next(first.begin(), first.end() - 1);
+	for (const auto& edge : result.edges) {
+		neighbors[next[edge.u]++] = edge.v;
+		neighbors[next[edge.v]++] = edge.u;
+	}
+
+	// each tree is walked from its smallest node
+	result.parent.assign(nodesNumber, -1);
+	result.component.assign(nodesNumber, -1);
+	vector<bool> visited(nodesNumber, false);
+	vector<Index> stack;
+	for (size_t root = 0; root < nodesNumber; ++root) {
+		if (visited[root]) continue;
+		visited[root] = true;
+		result.componentsNumber++;
+
+		const Index component = static_cast<Index>(result.componentsNumber - 1);
+		stack.push_back(static_cast<Index>(root));
+		while (!stack.empty()) {
+			Index node = stack.back();
+			stack.pop_back();
+			result.component[node] = component;
+			for (size_t i = first[node]; i < first[node + 1]; ++i) {
+				if (!visited[neighbors[i]]) {
+					visited[neighbors[i]] = true;
+					result.parent[neighbors[i]] = node;
+					stack.push_back(neighbors[i]);
+				}
+			}
+		}
+	}
+
+	result.componentWeights.assign(result.componentsNumber, 0);
+	for (const auto& edge : result.edges) {
+		result.componentWeights[result.component[edge.u]] += edge.weight;
+	}
+
+	return result;
+}
+
+// sets the ids of edges given by their endpoints, for engines that don't number the edges while they run
+// O(m + k log k) for k edges: the edges are sorted by their smaller endpoint and the other one, then the graph is read once
+// and each entry of a node is looked up among the edges of that node
+template<typename Graph, typename Weight, typename Index>
+void assignEdgeIds(const Graph& graph, vector<MSTEdge<Weight, Index>>& edges)
+{
+	using Access = GraphAccess<Graph>;
+	const size_t nodesNumber = Access::nodesNumber(graph);
+
+	for (auto& edge : edges) {
+		if (edge.u > edge.v) swap(edge.u, edge.v);
+		edge.id = noEdgeId;
+	}
+
+	vector<size_t> order(edges.size());
+	iota(order.begin(), order.end(), size_t{ 0 });
+	sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+		return tie(edges[a].u, edges[a].v, edges[a].weight) < tie(edges[b].u, edges[b].v, edges[b].weight);
+	});
+
+	uint64_t id = 0;
+	size_t next = 0;
+	for (size_t node = 0; node < nodesNumber; ++node) {
+		// edges whose smaller endpoint is the node
+		const auto begin = order.begin() + next;
+		while (next < order.size() && static_cast<size_t>(edges[order[next]].u) == node) next++;
+		const auto end = order.begin() + next;
+
+		Access::forEachNeighbor(graph, node, [&](Index neighbor, Weight weight) {
+			if (static_cast<size_t>(neighbor) <= node) return;
+
+			if (begin != end) {
+				// the first entry with the same endpoint and weight, parallel edges of equal weight are interchangeable
+				auto it = lower_bound(begin, end, make_pair(neighbor, weight), [&](size_t edge, const pair<Index, Weight>& key) {
+					return tie(edges[edge].v, edges[edge].weight) < tie(key.first, key.second);
+				});
+				if (it != end && edges[*it].v == neighbor && edges[*it].weight == weight && edges[*it].id == noEdgeId) edges[*it].id = id;
+			}
+			id++;
+		});
+	}
+}
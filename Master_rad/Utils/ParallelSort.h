@@ -0,0 +1,84 @@
+#pragma once
+
+#include "TaskPool.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+// stable LSD radix sort by 64-bit keys (keyOf(value) returns the key), 8 bits per pass
+// every pass counts the digits of each chunk in parallel and then each chunk moves its values to their own positions,
+// so the result doesn't depend on the number of workers
+// passes over the digits that are the same in all keys are skipped (e.g. packed edges of a small graph have many zero bits)
+template<typename T, typename KeyOf>
+void parallelRadixSort(vector<T>& values, KeyOf keyOf, unsigned workersNumber = 0)
+{
+	const size_t n = values.size();
+	if (n < 2) return;
+
+	if (!workersNumber) workersNumber = defaultWorkersNumber();
+
+	// small chunks are not worth the threads
+	const size_t minChunk = 1 << 15;
+	const size_t chunks = max<size_t>(1, min<size_t>(workersNumber, n / minChunk));
+	auto chunkBegin = [&](size_t chunk) { return chunk * n / chunks; };
+
+	// bits that are 1 in some key and 0 in another one
+	vector<uint64_t> ones(chunks, 0), zeros(chunks, 0);
+	runTasks(chunks, [&](size_t chunk) {
+		for (size_t i = chunkBegin(chunk); i < chunkBegin(chunk + 1); ++i) {
+			uint64_t key = keyOf(values[i]);
+			ones[chunk] |= key;
+			zeros[chunk] |= ~key;
+		}
+	}, workersNumber);
+
+	uint64_t anyOne = 0, anyZero = 0;
+	for (size_t chunk = 0; chunk < chunks; ++chunk) {
+		anyOne |= ones[chunk];
+		anyZero |= zeros[chunk];
+	}
+	const uint64_t varying = anyOne & anyZero;
+
+	vector<T> buffer(n);
+	vector<size_t> positions(chunks * 256);
+
+	for (int shift = 0; shift < 64; shift += 8) {
+		if (!((varying >> shift) & 0xff)) continue;
+
+		fill(positions.begin(), positions.end(), 0);
+		runTasks(chunks, [&](size_t chunk) {
+			size_t* counts = &positions[chunk * 256];
+			for (size_t i = chunkBegin(chunk); i < chunkBegin(chunk + 1); ++i) {
+				counts[(keyOf(values[i]) >> shift) & 0xff]++;
+			}
+		}, workersNumber);
+
+		// values with the digit d from the chunk c go after all smaller digits and after the digit d of the previous chunks
+		size_t position = 0;
+		for (size_t digit = 0; digit < 256; ++digit) {
+			for (size_t chunk = 0; chunk < chunks; ++chunk) {
+				size_t count = positions[chunk * 256 + digit];
+				positions[chunk * 256 + digit] = position;
+				position += count;
+			}
+		}
+
+		runTasks(chunks, [&](size_t chunk) {
+			size_t* next = &positions[chunk * 256];
+			for (size_t i = chunkBegin(chunk); i < chunkBegin(chunk + 1); ++i) {
+				buffer[next[(keyOf(values[i]) >> shift) & 0xff]++] = values[i];
+			}
+		}, workersNumber);
+
+		values.swap(buffer);
+	}
+}
+
+// radix sort of the keys themselves
+inline void parallelRadixSort(vector<uint64_t>& values, unsigned workersNumber = 0)
+{
+	parallelRadixSort(values, [](uint64_t value) { return value; }, workersNumber);
+}
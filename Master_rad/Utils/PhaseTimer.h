@@ -0,0 +1,38 @@
+#pragma once
+
+#include <chrono>
+
+using namespace std;
+
+// time spent in each phase of an MST engine in milliseconds
+// all engines report the same phases, so they can be compared phase by phase
+struct PhaseTimes
+{
+	// adjacency list -> engine's own representation of the graph (edge list, CSR, Graph...)
+	double conversion{ 0 };
+	// sorting of the edges, initial heaps and other preparation before the main loop
+	double preprocessing{ 0 };
+	// main loop of the algorithm
+	double core{ 0 };
+	// MST edges -> result (total weight)
+	double materialization{ 0 };
+
+	double total() const { return conversion + preprocessing + core + materialization; }
+};
+
+// measures consecutive phases: finish(phase) adds the time since the previous call (or since the construction) to the phase
+class PhaseTimer
+{
+public:
+	PhaseTimer() : m_last(chrono::steady_clock::now()) {}
+
+	void finish(double& phase)
+	{
+		auto now = chrono::steady_clock::now();
+		phase += chrono::duration<double, milli>(now - m_last).count();
+		m_last = now;
+	}
+
+private:
+	chrono::steady_clock::time_point m_last;
+};
@@ -0,0 +1,510 @@
+// MIT License
+// 
+// Copyright (c) 2020 Aleksey Loginov
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// This source is the original source from the paper with small modifications:
+// - the heap is parameterized by comparator and allocator, so it can be used outside of Chazelle's algorithm
+// - melding leaves the other heap empty and removed heads are unlinked, so no memory is leaked
+//
+// Soft heap is an approximate priority queue. Items are inserted with their keys, but some of the keys
+// can be raised (corrupted) by the heap. With parameter r = CalculateRByEps(eps) at most eps * n items are
+// corrupted at any time, and each operation costs O(1) amortized (insert O(log 1/eps)).
+// The callback passed to the constructor is called every time the key of some item is raised:
+// item is the stored item and ckey is the new (corrupted) key.
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <list>
+#include <memory>
+#include <stdexcept>
+
+// soft heap parameter r for the error rate eps, 0 < eps < 1
+inline size_t CalculateRByEps(double eps)
+{
+    assert(0.0 < eps && eps < 1.0);
+    return static_cast<size_t>(2.0 + 2.0 * std::ceil(std::log(1.0 / eps)));
+}
+
+template<typename ItemType, typename Compare = std::less<ItemType>, typename Allocator = std::allocator<ItemType>>
+class SoftHeap
+{
+public:
+    using OnKeyRaised = std::function<void(ItemType& item, const ItemType& ckey)>;
+
+    // heaps that are melded must use equal allocators
+    explicit SoftHeap(size_t r, OnKeyRaised on_key_raised = {}, Compare compare = {}, const Allocator& allocator = {});
+    SoftHeap(SoftHeap&& other) noexcept;
+    virtual ~SoftHeap();
+
+    SoftHeap(const SoftHeap& other) = delete;
+    SoftHeap& operator=(const SoftHeap& other) = delete;
+    SoftHeap& operator=(SoftHeap&& other) = delete;
+
+    virtual void Insert(ItemType new_key);
+    // removes one of the items with the smallest (possibly corrupted) key, throws std::out_of_range if the heap is empty
+    virtual ItemType DeleteMin();
+
+    // moves all items of the other heap to this one, the other heap remains empty
+    void Meld(SoftHeap& other);
+
+    // one of the items with the smallest (possibly corrupted) key, nullptr if the heap is empty
+    virtual ItemType* FindMin();
+
+    size_t Size() const { return m_size; }
+    bool Empty() const { return m_size == 0; }
+private:
+    struct Node;
+    struct Head;
+
+    using ValueList = std::list<ItemType, Allocator>;
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+    struct NodeDeleter
+    {
+        NodeAllocator m_allocator;
+
+        void operator()(Node* node)
+        {
+            NodeTraits::destroy(m_allocator, node);
+            NodeTraits::deallocate(m_allocator, node, 1);
+        }
+    };
+
+    using NodePtr = std::unique_ptr<Node, NodeDeleter>;
+
+    // nullptr is the infinite key
+    static bool CkeyLess(const Compare& compare, const ItemType* lhs, const ItemType* rhs)
+    {
+        if (!lhs) // aka infinity < const_value
+            return false;
+
+        if (!rhs) // aka const_value < infinity
+            return true;
+
+        return compare(*lhs, *rhs);
+    }
+
+    struct Node
+    {
+        Node(ItemType item, const Allocator& allocator)
+            : m_ckey{ std::allocate_shared<ItemType>(allocator, item) }
+            , m_rank{ 0 }
+            , m_values{ std::allocate_shared<ValueList>(allocator, allocator) }
+        {
+            m_values->push_front(std::move(item));
+        }
+
+        Node(NodePtr top, NodePtr bottom)
+            : m_ckey{ top->m_ckey }
+            , m_rank{ top->m_rank + 1 }
+            , m_next{ std::move(top) }
+            , m_child{ std::move(bottom) }
+            , m_values{ m_next->m_values } {
+        }
+
+        size_t GetRank() const { return m_rank; }
+        [[nodiscard]] const ItemType* GetCkey() const { return m_ckey.get(); }
+        bool IsInfntyCkey() const { return !m_ckey; }
+        [[nodiscard]] NodePtr ExtractChild() { return std::move(m_child); }
+
+
+        bool IsNoValues() const { return !m_values || m_values->empty(); }
+
+        void Sift(size_t r, const OnKeyRaised& action, const Compare& compare);
+
+        void ForEachNodeWithChildOnLevel(std::function<void(Node* node)> func)
+        {
+            if (m_next)
+            {
+                func(this);
+                m_next->ForEachNodeWithChildOnLevel(std::move(func));
+            }
+        }
+
+        ItemType& FrontValue()
+        {
+            assert(!!m_values && !m_values->empty());
+            return m_values->front();
+        }
+
+        ItemType PopValue()
+        {
+            assert(!!m_values && !m_values->empty());
+
+            auto value = std::move(m_values->front());
+            m_values->pop_front();
+
+            return value;
+        }
+
+    private:
+        std::shared_ptr<ItemType> m_ckey;
+        const size_t m_rank;
+        NodePtr m_next{};
+        NodePtr m_child{};
+        std::shared_ptr<ValueList> m_values{};
+    };
+
+    struct Head
+    {
+        Head(size_t rank, NodePtr queue = {})
+            : m_queue{ std::move(queue) }
+            , m_rank{ rank } {
+        }
+
+        NodePtr ExtractQueue() { return std::move(m_queue); }
+
+        const NodePtr& GetQueue() const { return m_queue; }
+        const std::shared_ptr<Head>& GetNext() const { return m_next; }
+        const std::shared_ptr<Head>& GetPrev() const { return m_prev; }
+        const std::shared_ptr<Head>& GetSuffixMin() const { return m_suffix_min; }
+        size_t GetRank() const { return m_rank; }
+
+        void SetNext(const std::shared_ptr<Head>& next) { m_next = next; }
+        void SetPrev(const std::shared_ptr<Head>& prev) { m_prev = prev; }
+        void SetSuffixMin(const std::shared_ptr<Head>& suffix_min) { m_suffix_min = suffix_min; }
+
+        // heads point to each other (and possibly to themselves), links are cleared so they can be released
+        void ClearLinks()
+        {
+            m_next.reset();
+            m_prev.reset();
+            m_suffix_min.reset();
+        }
+    private:
+        NodePtr m_queue{};
+        std::shared_ptr<Head> m_next{};
+        std::shared_ptr<Head> m_prev{};
+        std::shared_ptr<Head> m_suffix_min{};
+        const size_t m_rank{};
+    };
+
+    template<typename... Args>
+    NodePtr MakeNode(Args&&... args);
+    Node* FindMinNode();
+    void  Meld(NodePtr q);
+    void  FixMinlist(std::shared_ptr<Head> h);
+    // removes the head from the list of heads and returns the previous one
+    std::shared_ptr<Head> RemoveHead(const std::shared_ptr<Head>& h);
+    // releases all heads, the heap is left without header and tail
+    void  ReleaseHeads();
+    void  InitHeads();
+private:
+    std::shared_ptr<Head> m_header{};
+    std::shared_ptr<Head> m_tail{};
+    const size_t m_r;
+    const OnKeyRaised m_on_key_raised;
+    const Compare m_compare;
+    Allocator m_allocator;
+    size_t m_size{ 0 };
+};
+
+template<typename ItemType, typename Compare, typename Allocator>
+SoftHeap<ItemType, Compare, Allocator>::SoftHeap(size_t r, OnKeyRaised on_key_raised, Compare compare, const Allocator& allocator)
+    : m_r(r)
+    , m_on_key_raised{ std::move(on_key_raised) }
+    , m_compare{ std::move(compare) }
+    , m_allocator{ allocator }
+{
+    InitHeads();
+}
+
+template<typename ItemType, typename Compare, typename Allocator>
+SoftHeap<ItemType, Compare, Allocator>::SoftHeap(SoftHeap&& other) noexcept
+    : m_header{ std::move(other.m_header) }
+    , m_tail{ std::move(other.m_tail) }
+    , m_r(other.m_r)
+    , m_on_key_raised{ other.m_on_key_raised }
+    , m_compare{ other.m_compare }
+    , m_allocator{ other.m_allocator }
+    , m_size{ other.m_size }
+{
+    other.m_size = 0;
+}
+
+template<typename ItemType, typename Compare, typename Allocator>
+SoftHeap<ItemType, Compare, Allocator>::~SoftHeap()
+{
+    ReleaseHeads();
+}
+
+template<typename ItemType, typename Compare, typename Allocator>
+void SoftHeap<ItemType, Compare, Allocator>::InitHeads()
+{
+    m_header = std::allocate_shared<Head>(m_allocator, 0);
+    m_tail = std::allocate_shared<Head>(m_allocator, std::numeric_limits<size_t>::max());
+
+    m_header->SetNext(m_tail);
+    m_tail->SetPrev(m_header);
+}
+
+template<typename ItemType, typename Compare, typename Allocator>
+void SoftHeap<ItemType, Compare, Allocator>::ReleaseHeads()
+{
+    auto h = m_header;
+    while (h)
+    {
+        auto next = h->GetNext();
+        h->ClearLinks();
+        h = next;
+    }
+    m_header.reset();
+    m_tail.reset();
+}
+
+template<typename ItemType, typename Compare, typename Allocator>
+template<typename... Args>
+typename SoftHeap<ItemType, Compare, Allocator>::NodePtr SoftHeap<ItemType, Compare, Allocator>::MakeNode(Args&&... args)
+{
+    NodeAllocator allocator{ m_allocator };
+    Node* node = NodeTraits::allocate(allocator, 1);
+    try
+    {
+        NodeTraits::construct(allocator, node, std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+        NodeTraits::deallocate(allocator, node, 1);
+        throw;
+    }
+    return NodePtr{ node, NodeDeleter{ allocator } };
+}
+
+template<typename ItemType, typename Compare, typename Allocator>
+void SoftHeap<ItemType, Compare, Allocator>::Insert(ItemType new_key)
+{
+    Meld(MakeNode(std::move(new_key), m_allocator));
+    ++m_size;
+}
+
+template<typename ItemType, typename Compare, typename Allocator>
+ItemType* SoftHeap<ItemType, Compare, Allocator>::FindMin()
+{
+    auto node = FindMinNode();
+    if (!node || node->IsNoValues())
+        return nullptr;
+    return &node->FrontValue();
+}
+
+template<typename ItemType, typename Compare, typename Allocator>
+ItemType SoftHeap<ItemType, Compare, Allocator>::DeleteMin()
+{
+    if (Empty())
+        throw std::out_of_range("DeleteMin on an empty soft heap");
+
+    auto node = FindMinNode();
+    assert(node);
+    --m_size;
+    return node->PopValue();
+}
+
+template<typename ItemType, typename Compare, typename Allocator>
+void SoftHeap<ItemType, Compare, Allocator>::Meld(SoftHeap& other)
+{
+    if (&other == this)
+        return;
+
+    auto h = other.m_header->GetNext();
+
+    while (h != other.m_tail)
+    {
+        Meld(h->ExtractQueue());
+        h = h->GetNext();
+    }
+
+    m_size += other.m_size;
+
+    // other heap is empty now
+    other.ReleaseHeads();
+    other.InitHeads();
+    other.m_size = 0;
+}
+
+template<typename ItemType, typename Compare, typename Allocator>
+std::shared_ptr<typename SoftHeap<ItemType, Compare, Allocator>::Head> SoftHeap<ItemType, Compare, Allocator>::RemoveHead(const std::shared_ptr<Head>& h)
+{
+    auto prev = h->GetPrev();
+    prev->SetNext(h->GetNext());
+    h->GetNext()->SetPrev(prev);
+    h->ClearLinks();
+
+    return prev;
+}
+
+template<typename ItemType, typename Compare, typename Allocator>
+typename SoftHeap<ItemType, Compare, Allocator>::Node* SoftHeap<ItemType, Compare, Allocator>::FindMinNode()
+{
+    assert(m_header->GetNext());
+
+    std::shared_ptr<Head> h = m_header->GetNext()->GetSuffixMin();
+    while (h && h->GetQueue()->IsNoValues())
+    {
+        size_t                                               child_count = 0;
+        h->GetQueue()->ForEachNodeWithChildOnLevel([&](Node*) { child_count += 1; });
+
+        if (child_count < h->GetRank() / 2)
+        {
+            FixMinlist(RemoveHead(h));
+
+            h->GetQueue()->ForEachNodeWithChildOnLevel([&](Node* node)
+                {
+                    Meld(node->ExtractChild());
+                });
+        }
+        else
+        {
+            h->GetQueue()->Sift(m_r, m_on_key_raised, m_compare);
+            if (h->GetQueue()->IsInfntyCkey())
+            {
+                h = RemoveHead(h);
+            }
+            FixMinlist(h);
+        }
+        h = m_header->GetNext()->GetSuffixMin();
+    } /* end of outer while loop */
+
+    return h ? h->GetQueue().get() : nullptr;
+}
+
+template<typename ItemType, typename Compare, typename Allocator>
+void SoftHeap<ItemType, Compare, Allocator>::Meld(NodePtr q)
+{
+    auto tohead = m_header->GetNext();
+    while (q->GetRank() > tohead->GetRank())
+        tohead = tohead->GetNext();
+
+    auto prevhead = tohead->GetPrev();
+
+    while (q->GetRank() == tohead->GetRank())
+    {
+        NodePtr top;
+        NodePtr bottom;
+        if (CkeyLess(m_compare, q->GetCkey(), tohead->GetQueue()->GetCkey()))
+        {
+            top = std::move(q);
+            bottom = std::move(tohead->ExtractQueue());
+        }
+        else
+        {
+            top = std::move(tohead->ExtractQueue());
+            bottom = std::move(q);
+        }
+        q = MakeNode(std::move(top), std::move(bottom));
+
+        // head is replaced by the new one
+        auto consumed = tohead;
+        tohead = tohead->GetNext();
+        consumed->ClearLinks();
+    }
+
+    auto rank = q->GetRank();
+    auto h = std::allocate_shared<Head>(m_allocator, rank, std::move(q));
+    h->SetPrev(prevhead);
+    h->SetNext(tohead);
+    prevhead->SetNext(h);
+    tohead->SetPrev(h);
+
+    FixMinlist(h);
+}
+
+template<typename ItemType, typename Compare, typename Allocator>
+void SoftHeap<ItemType, Compare, Allocator>::FixMinlist(std::shared_ptr<Head> h)
+{
+    std::shared_ptr<Head> tmpmin;
+    if (h->GetNext() == m_tail)
+        tmpmin = h;
+    else
+        tmpmin = h->GetNext()->GetSuffixMin();
+    while (h != m_header)
+    {
+        if (CkeyLess(m_compare, h->GetQueue()->GetCkey(), tmpmin->GetQueue()->GetCkey()))
+            tmpmin = h;
+        h->SetSuffixMin(tmpmin);
+        h = h->GetPrev();
+    }
+}
+
+template<typename ItemType, typename Compare, typename Allocator>
+void SoftHeap<ItemType, Compare, Allocator>::Node::Sift(const size_t r, const OnKeyRaised& action, const Compare& compare)
+{
+    m_values.reset();
+    if (!m_next && !m_child)
+    {
+        m_ckey.reset();
+        return;
+    }
+
+    m_next->Sift(r, action, compare);
+
+    if (CkeyLess(compare, m_child->GetCkey(), m_next->GetCkey()))
+        std::swap(m_child, m_next);
+
+    m_values = m_next->m_values;
+    m_ckey = m_next->m_ckey;
+
+    // Sometimes we can do it twice due branching
+    if (GetRank() > r &&
+        (GetRank() % 2 == 1 || m_child->GetRank() < GetRank() - 1))
+    {
+        m_next->Sift(r, action, compare);
+
+        if (CkeyLess(compare, m_child->GetCkey(), m_next->GetCkey()))
+            std::swap(m_child, m_next);
+
+        // Concatenate lists if not empty
+        if (!m_next->IsInfntyCkey() && !m_next->m_values->empty())
+        {
+            m_values->insert(m_values->begin(),
+                std::make_move_iterator(m_next->m_values->begin()),
+                std::make_move_iterator(m_next->m_values->end()));
+            m_next->m_values->clear();
+            m_next->m_values.reset();
+            m_ckey = m_next->m_ckey;
+            // callback is optional
+            for (auto& value : *m_values)
+            {
+                if (action && compare(value, *m_ckey))
+                    action(value, *m_ckey);
+            }
+        }
+    } /*  end of second sift */
+
+    // Clean Up
+    if (!m_child->IsInfntyCkey())
+        return;
+
+    if (m_next->IsInfntyCkey())
+    {
+        m_child.reset();
+        m_next.reset();
+    }
+    else
+    {
+        m_child = std::move(m_next->m_child);
+        m_next = std::move(m_next->m_next);
+    }
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "SoftHeap.h"
+#include "SoftHeapSelect.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// compares soft heap with the standard library:
+// - selection of the median: SoftHeapSelect vs std::nth_element
+// - n inserts followed by n deletions of the minimum: SoftHeap (eps = 1/3) vs std::priority_queue
+// results are written in the same format as the MST benchmarks (algo;n;ms)
+
+namespace softheapbench {
+
+    using Clock = std::chrono::steady_clock;
+    using ms = std::chrono::duration<double, std::milli>;
+
+    inline std::vector<int> randomValues(std::size_t n, std::uint32_t seed) {
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<int> dist(0, 1000000000);
+
+        std::vector<int> values(n);
+        for (auto& value : values) value = dist(gen);
+        return values;
+    }
+
+    inline double measure(const std::function<void()>& action) {
+        auto start = Clock::now();
+        action();
+        auto end = Clock::now();
+        return std::chrono::duration_cast<ms>(end - start).count();
+    }
+
+    inline void benchSoftHeap(const std::vector<int>& inputSize, const std::vector<std::uint32_t>& seed, const std::string& path) {
+
+        std::ofstream csv(path);
+        csv << "algo;n;ms\n"; // header
+
+        for (auto n : inputSize) {
+            double softSelect = 0, nthElement = 0, softQueue = 0, priorityQueue = 0;
+
+            for (auto s : seed) {
+                const auto values = randomValues(static_cast<std::size_t>(n), s);
+                const std::size_t k = (values.size() - 1) / 2;
+
+                int selected = 0, expected = 0;
+
+                softSelect += measure([&]() { selected = SoftHeapSelect(values, k); });
+                nthElement += measure([&]() {
+                    auto copy = values;
+                    std::nth_element(copy.begin(), copy.begin() + k, copy.end());
+                    expected = copy[k];
+                    });
+
+                if (selected != expected) throw std::runtime_error("SoftHeapSelect returned a wrong value");
+
+                softQueue += measure([&]() {
+                    SoftHeap<int> heap(CalculateRByEps(1.0 / 3.0));
+                    for (auto value : values) heap.Insert(value);
+                    while (!heap.Empty()) heap.DeleteMin();
+                    });
+                priorityQueue += measure([&]() {
+                    std::priority_queue<int, std::vector<int>, std::greater<int>> heap;
+                    for (auto value : values) heap.push(value);
+                    while (!heap.empty()) heap.pop();
+                    });
+            }
+
+            const double count = static_cast<double>(seed.size());
+            csv << "SoftHeapSelect" << ';' << n << ';' << softSelect / count << '\n';
+            csv << "nth_element" << ';' << n << ';' << nthElement / count << '\n';
+            csv << "SoftHeap" << ';' << n << ';' << softQueue / count << '\n';
+            csv << "priority_queue" << ';' << n << ';' << priorityQueue / count << '\n';
+        }
+    }
+
+} // namespace softheapbench
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "SoftHeap.h"
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+// Linear time selection using soft heap.
+// All values are inserted into a soft heap with error rate 1/3 and n/3 of them are deleted. The largest
+// deleted value has rank between n/3 and 2n/3, so it is a good pivot and every step discards
+// a constant part of the values. Total complexity is O(n).
+
+// smaller ranges are solved by std::nth_element
+constexpr size_t SoftHeapSelectCutoff = 32;
+
+// returns the k-th smallest value (k = 0 is the minimum), values are reordered
+template<typename T, typename Compare = std::less<T>>
+T SoftHeapSelectInPlace(std::vector<T>& values, size_t k, Compare compare = {})
+{
+    if (k >= values.size())
+        throw std::out_of_range("k must be smaller than the number of values");
+
+    auto first = values.begin();
+    auto last = values.end();
+
+    while (static_cast<size_t>(last - first) > SoftHeapSelectCutoff)
+    {
+        const size_t n = static_cast<size_t>(last - first);
+
+        SoftHeap<T, Compare> heap(CalculateRByEps(1.0 / 3.0), {}, compare);
+        for (auto itr = first; itr != last; ++itr)
+            heap.Insert(*itr);
+
+        T pivot = heap.DeleteMin();
+        for (size_t i = 1; i < n / 3; ++i)
+        {
+            T removed = heap.DeleteMin();
+            if (compare(pivot, removed))
+                pivot = std::move(removed);
+        }
+
+        // three parts: smaller than pivot, equal to pivot and greater than pivot
+        const auto lessEnd = std::partition(first, last, [&](const T& value) { return compare(value, pivot); });
+        const auto equalEnd = std::partition(lessEnd, last, [&](const T& value) { return !compare(pivot, value); });
+
+        const size_t lessCount = static_cast<size_t>(lessEnd - first);
+        const size_t equalCount = static_cast<size_t>(equalEnd - lessEnd);
+
+        if (k < lessCount)
+        {
+            last = lessEnd;
+        }
+        else if (k < lessCount + equalCount)
+        {
+            return pivot;
+        }
+        else
+        {
+            k -= lessCount + equalCount;
+            first = equalEnd;
+        }
+    }
+
+    std::nth_element(first, first + k, last, compare);
+    return *(first + k);
+}
+
+template<typename T, typename Compare = std::less<T>>
+T SoftHeapSelect(std::vector<T> values, size_t k, Compare compare = {})
+{
+    return SoftHeapSelectInPlace(values, k, std::move(compare));
+}
+
+// lower median of the values
+template<typename T, typename Compare = std::less<T>>
+T SoftHeapMedian(std::vector<T> values, Compare compare = {})
+{
+    if (values.empty())
+        throw std::out_of_range("median of empty range");
+
+    const size_t k = (values.size() - 1) / 2;
+    return SoftHeapSelectInPlace(values, k, std::move(compare));
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// number of workers used when the caller does not ask for a specific one
+inline unsigned defaultWorkersNumber()
+{
+	return max(1u, thread::hardware_concurrency());
+}
+
+// runs task(0), ..., task(count - 1) on a fixed set of worker threads
+// each worker takes the next unprocessed index, so tasks of different sizes are balanced automatically
+// the calling thread is one of the workers, the first exception thrown by any task is rethrown after all workers finish
+inline void runTasks(size_t count, const function<void(size_t)>& task, unsigned workersNumber = 0)
+{
+	if (!workersNumber) workersNumber = defaultWorkersNumber();
+	workersNumber = static_cast<unsigned>(min<size_t>(workersNumber, count));
+
+	if (workersNumber <= 1) {
+		for (size_t i = 0; i < count; ++i) {
+			task(i);
+		}
+		return;
+	}
+
+	atomic<size_t> nextTask{ 0 };
+	exception_ptr firstError;
+	mutex errorMutex;
+
+	auto worker = [&]() {
+		for (size_t i = nextTask.fetch_add(1); i < count; i = nextTask.fetch_add(1)) {
+			try {
+				task(i);
+			}
+			catch (...) {
+				lock_guard<mutex> lock(errorMutex);
+				if (!firstError) firstError = current_exception();
+			}
+		}
+	};
+
+	vector<thread> workers;
+	workers.reserve(workersNumber - 1);
+	for (unsigned i = 1; i < workersNumber; ++i) {
+		workers.emplace_back(worker);
+	}
+
+	worker();
+
+	for (auto& w : workers) {
+		w.join();
+	}
+
+	if (firstError) rethrow_exception(firstError);
+}
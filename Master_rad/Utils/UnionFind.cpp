@@ -1,27 +1,42 @@
 #include "UnionFind.h"
 
-UnionFind::UnionFind(int nodesNumber)
+template<typename Index>
+BasicUnionFind<Index>::BasicUnionFind(Index nodesNumber)
 	: m_nodesNumber(nodesNumber)
 	, m_componentNumber(nodesNumber)
 	, m_parent(nodesNumber, -1)
 	, m_rang(nodesNumber, 0)
 {
 	// initially, each vertex is separate component and its own parent 
-	for (int i = 0; i < m_nodesNumber; i++) {
+	for (Index i = 0; i < m_nodesNumber; i++) {
 		m_parent[i] = i;
 		m_rang[i] = 0;
 	}
 }
 
-void UnionFind::ensureSize(int n)
+template<typename Index>
+void BasicUnionFind<Index>::reset(Index nodesNumber)
+{
+	m_nodesNumber = nodesNumber;
+	m_componentNumber = nodesNumber;
+	m_parent.resize(nodesNumber);
+	m_rang.assign(nodesNumber, 0);
+
+	for (Index i = 0; i < m_nodesNumber; i++) {
+		m_parent[i] = i;
+	}
+}
+
+template<typename Index>
+void BasicUnionFind<Index>::ensureSize(Index n)
 {
 	if (n <= m_nodesNumber) return;
 
-	int oldNodesNumber = m_nodesNumber;
+	Index oldNodesNumber = m_nodesNumber;
 	m_parent.resize(n);
 	m_rang.resize(n);
 
-	for (int i = oldNodesNumber; i < n; ++i) {
+	for (Index i = oldNodesNumber; i < n; ++i) {
 		// new nodes
 		m_parent[i] = i;   
 		m_rang[i] = 0;
@@ -31,13 +46,14 @@ void UnionFind::ensureSize(int n)
 	m_nodesNumber = n;
 }
 
-int UnionFind::find(int x) {
-	int root = x;
+template<typename Index>
+Index BasicUnionFind<Index>::find(Index x) {
+	Index root = x;
 	while (root != m_parent[root]) {
 		root = m_parent[root];
 	}
 	while (x != root) {
-		int tmp = m_parent[x];
+		Index tmp = m_parent[x];
 		m_parent[x] = root;
 		x = tmp;
 	}
@@ -46,9 +62,10 @@ int UnionFind::find(int x) {
 }
 
 // union operation, it merges two components
-void UnionFind::unionOperation(int x, int y) {
-	int fx = find(x);
-	int fy = find(y);
+template<typename Index>
+void BasicUnionFind<Index>::unionOperation(Index x, Index y) {
+	Index fx = find(x);
+	Index fy = find(y);
 
 	if (fx == fy) return;
 
@@ -69,14 +86,16 @@ void UnionFind::unionOperation(int x, int y) {
 }
 
 // checks if x and y belong to the same component 
-bool UnionFind::connected(int x, int y) {
+template<typename Index>
+bool BasicUnionFind<Index>::connected(Index x, Index y) {
 	return find(x) == find(y);
 }
 
-set<int> UnionFind::getComponents() {
-	set<int> components; 
+template<typename Index>
+set<Index> BasicUnionFind<Index>::getComponents() {
+	set<Index> components; 
 
-	for (int i = 0; i < m_parent.size(); ++i) {
+	for (Index i = 0; i < static_cast<Index>(m_parent.size()); ++i) {
 		if (i == m_parent[i]) {
 			components.insert(i);
 		}
@@ -84,3 +103,5 @@ set<int> UnionFind::getComponents() {
 	return components;
 }
 
+template class BasicUnionFind<int>;
+template class BasicUnionFind<long long>;
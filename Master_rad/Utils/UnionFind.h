@@ -8,31 +8,42 @@
 
 using namespace std;
 
-class UnionFind
+// Index is the type of the node ids, graphs with more than 2^31 nodes need a 64-bit one
+// the members are defined in UnionFind.cpp, which instantiates int and long long
+template<typename Index = int>
+class BasicUnionFind
 {
 public:
-    UnionFind(int nodesNumber);
+    BasicUnionFind(Index nodesNumber = 0);
+
+	// separate components again, the memory is kept for the next graph
+	void reset(Index nodesNumber);
 
 	// handle the case when graph is created using default constructor 
-	void ensureSize(int n);
+	void ensureSize(Index n);
 
 	// return the parent of node x
-	int find(int x);
+	Index find(Index x);
 	// number of components (initially vertices)
-	int getComponentNumber() const { return m_componentNumber; }
+	Index getComponentNumber() const { return m_componentNumber; }
 
 	// merge components
-	void unionOperation(int x, int y);
+	void unionOperation(Index x, Index y);
 
 	//check if two nodes belong to the same component
-	bool connected(int x, int y);
+	bool connected(Index x, Index y);
 
-	set<int> getComponents();
+	set<Index> getComponents();
 
 private:
-    int m_nodesNumber{ 0 };
-    int m_componentNumber{ 0 };
+    Index m_nodesNumber{ 0 };
+    Index m_componentNumber{ 0 };
+
+    vector<Index> m_parent;
+    vector<Index> m_rang;
+};
+
+extern template class BasicUnionFind<int>;
+extern template class BasicUnionFind<long long>;
 
-    vector<int> m_parent;
-    vector<int> m_rang;
-};
\ No newline at end of file
+using UnionFind = BasicUnionFind<int>;
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// weight types of the templated engines (Prim, Kruskal, Boruvka)
+// integer weights are summed in 64 bits, floating point weights in double
+// every value of the type is a valid weight, so the engines mark unset distances with flags or parents and not with a weight
+template<typename Weight>
+struct WeightTraits
+{
+	using Sum = conditional_t<is_floating_point_v<Weight>, double, conditional_t<is_signed_v<Weight>, long long, unsigned long long>>;
+
+	// 8 and 16-bit weights have few values, so the edges are sorted by counting and the weight isn't stored with every edge
+	static constexpr bool countingSort = is_integral_v<Weight> && sizeof(Weight) <= 2;
+};
+
+// adjacency list with (neighbor, weight) pairs, the engines' input
+template<typename Weight = int, typename Index = int>
+using WeightedAdjacencyList = vector<vector<pair<Index, Weight>>>;
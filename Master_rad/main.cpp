@@ -1,21 +1,22 @@
-#include "Prim.cpp"
-#include "Kruskal.cpp"
-#include "Boruvka.cpp"
-#include "ReverseDelete.cpp"
-#include "Karger/Karger.cpp"
-#include "FredmanTarjan/FredmanTarjan.cpp"
-#include "Chazelle/Chazelle.cpp"
-
-#include "GenerateGraph.hpp"
-
+#include "Benchmark/Engines.hpp"
+#include "Benchmark/Options.hpp"
+#include "Benchmark/PerfCounters.hpp"
+#include "Benchmark/Memory.hpp"
+#include "GraphIO/GraphFile.hpp"
+#include "GraphIO/MSTResultFile.hpp"
+#include "Utils/SoftHeapBenchmark.hpp"
+#include "Utils/Log.h"
+
+#include <algorithm>
 #include <numeric>
 #include <iostream>
 #include <fstream>
+#include <memory>
 
 
-vector<uint32_t> createSeed(int iterationNumber) {
+vector<uint32_t> createSeed(int iterationNumber, uint32_t masterSeed = 123456) {
 
-    std::mt19937 rng(123456);
+    std::mt19937 rng(masterSeed);
     std::uniform_int_distribution<uint32_t> U;
 
     vector<uint32_t> seed;
@@ -28,208 +29,357 @@ vector<uint32_t> createSeed(int iterationNumber) {
 }
 
 
-mstgen::AdjList generateGraph(size_t n, uint32_t seed) {
+mstgen::AdjList generateGraph(size_t n, uint32_t seed, const mstbench::GraphModel& model = {}) {
 
-    //double d = std::min(1.0, 3.0 / double(n));
+    double d = model.densityFor(n);
 
-    double k = 4.0;
-    double avg_deg = k * std::log((double)n);
-    double d = 0.1; /*(n > 1) ? std::min(1.0, avg_deg / (n - 1)) : 0.0;*/
+    if (model.generator == mstbench::GraphModel::Generator::BGL) {
+        mstgen::BGLGraph g = mstgen::make_connected_fixed_density_graph(n, d, seed);
 
-    mstgen::BGLGraph g = mstgen::make_connected_fixed_density_graph(n, d, seed);
+        // debug info, the connectivity check is a full pass over the graph, so it's done only with --log-level debug
+        MST_LOG(Debug, "V=" << boost::num_vertices(g) << "  E=" << boost::num_edges(g) << "  density=" << mstgen::density(g)
+            << "  connected=" << (mstgen::is_connected(g) ? 1 : 0));
 
-    auto [vi, ve] = boost::vertices(g);
-    auto [ei, ee] = boost::edges(g);
-    std::size_t V = static_cast<std::size_t>(std::distance(vi, ve));
-    std::size_t E = static_cast<std::size_t>(std::distance(ei, ee));
+        return mstgen::to_adjacency_list(g);
+    }
 
-    // debug info
-    std::cout << "V=" << V << "  E=" << E << "  density=" << mstgen::density(g) << "  connected=" << (mstgen::is_connected(g) ? 1 : 0) << endl;
+    mstgen::CSRGraph g = mstgen::make_family_csr(model.family, n, d, seed, model.weights);
 
-    /*for (int i = 0; i < adjacencyList.size(); i++) {
-        for (int j = 0; j < adjacencyList[i].size(); j++) {
-            cout << "(" << i << ", " << adjacencyList[i][j].first << ") weight: " << adjacencyList[i][j].second << endl;
-        }
-    }*/
+    // debug info, only with --log-level debug
+    MST_LOG(Debug, "V=" << g.nodesNumber() << "  E=" << g.edgesNumber() << "  density=" << mstgen::density(g)
+        << "  connected=" << (mstgen::is_connected(g) ? 1 : 0));
 
     return mstgen::to_adjacency_list(g);
 }
 
-int main() {
-
-	/*std::vector<std::vector<std::pair<int, int>>> adjacencyList{ {{1,7}, {2,6}},
-		{{0,7}, {2,2}, {3,3}}, {{0,6}, {1,2}, {3,4}, {4,5}},
-		{{1,3}, {2,4}, {4,1}}, {{2,5}, {3,1}} };*/
-
-	//std::vector<std::vector<std::pair<int, int>>> adjacencyList{
- //       /* 0 */{ {1,1}, {15,23} },
- //       /* 1 */{ {0,1}, {2,9}, {14,31} },
- //       /* 2 */{ {3,2}, {1,9}, {5,25} },
- //       /* 3 */{ {2,2}, {4,17} },
- //       /* 4 */{ {5,3}, {3,17} },
- //       /* 5 */{ {4,3}, {6,11}, {2,25} },
- //       /* 6 */{ {7,4}, {5,11}, {9,27} },
- //       /* 7 */{ {6,4}, {8,19} },
- //       /* 8 */{ {9,5}, {7,19} },
- //       /* 9 */{ {8,5}, {10,13}, {6,27} },
- //       /* 10 */{ {11,6}, {9,13}, {13,29} },
- //       /* 11 */{ {10,6}, {12,21} },
- //       /* 12 */{ {13,7}, {11,21} },
- //       /* 13 */{ {12,7}, {14,15}, {10,29} },
- //       /* 14 */{ {15,8}, {13,15}, {1,31} },
- //       /* 15 */{ {14,8}, {0,23} }
- //   };
-    
-
-    const int from = 100, to = 10000, step = 100;
-    const int count = (to - from) / step + 1;
+// inserts "-suffix" before the extension of the path, e.g. adversarial.csv -> adversarial-prim-worst.csv
+string withSuffix(const string& path, const string& suffix) {
+    const auto dot = path.rfind('.');
+    const auto slash = path.find_last_of("/\\");
+    const bool hasExtension = dot != string::npos && (slash == string::npos || dot > slash);
 
-    std::vector<int> inputSize(count);
-    for (int i = 0; i < count; ++i) {
-        inputSize[i] = i * step + from;
-    }
-
-    // number of iterations for each input size
-    int iterationNumber = 100;
+    return hasExtension ? path.substr(0, dot) + '-' + suffix + path.substr(dot) : path + '-' + suffix;
+}
 
-    vector<uint32_t> seed =  createSeed(iterationNumber);
+// runs Chazelle's algorithm with different soft heap error rates on the same graphs
+// total time is reported together with corruption statistics, so the best epsilon can be chosen for a graph family
+void tuneChazelleEpsilon(const vector<int>& inputSize, const vector<double>& epsilons, const vector<uint32_t>& seed,
+    const mstbench::GraphModel& model, const string& path) {
 
-    std::ofstream csv("benchDense.csv");
-    csv << "algo;n;ms\n"; // header
+    std::ofstream csv(path);
+    csv << "eps;r;n;ms;corruptions;corruptedEdges;trees;subgraphs;depth;badEdgesPerLevel\n"; // header
 
     for (auto n : inputSize) {
-        //cout << "Current n: " << n << endl;
-
-        double averageDuration = 0;
-        if (n > 5000) break;
-
-        for (int iter = 0; iter < iterationNumber; ++iter) {
-            auto adjacencyList = generateGraph(n, seed[iter]);
-            PrimsAlgorithm prim(adjacencyList);
-            //std::cout << "** " << prim.getDuration() << " ** " << endl;
-            averageDuration += prim.getDuration();
+        vector<double> averageDuration(epsilons.size(), 0);
+        vector<ChazelleStatistics> statistics(epsilons.size());
+        vector<size_t> r(epsilons.size(), 0);
+
+        // each graph is generated once and used for all error rates
+        for (size_t iter = 0; iter < seed.size(); ++iter) {
+            auto adjacencyList = generateGraph(n, seed[iter], model);
+
+            for (size_t i = 0; i < epsilons.size(); ++i) {
+                ChazelleOptions options{};
+                options.epsilon = epsilons[i];
+
+                Chazelle chazelle(adjacencyList, options);
+                averageDuration[i] += chazelle.getDuration();
+                statistics[i].merge(chazelle.getStatistics());
+                r[i] = chazelle.getR();
+            }
         }
-     
-        averageDuration = averageDuration / (double)iterationNumber;
-
-        csv << "Prim" << ';' << n << ';' << averageDuration << '\n';
-    }
-
-    for (auto n : inputSize) {
-        //cout << "Current n: " << n << endl;
 
-        double averageDuration = 0;
-        if (n > 5000) break;
+        for (size_t i = 0; i < epsilons.size(); ++i) {
+            csv << epsilons[i] << ';' << r[i] << ';' << n << ';' << averageDuration[i] / (double)seed.size() << ';'
+                << statistics[i].corruptionsNumber << ';' << statistics[i].corruptedEdgesNumber << ';'
+                << statistics[i].treesNumber << ';' << statistics[i].subgraphsNumber << ';' << statistics[i].recursionDepth << ';';
 
-        for (int iter = 0; iter < iterationNumber; ++iter) {
-            auto adjacencyList = generateGraph(n, seed[iter]);
-            KruskalAlgorithm kruskal(adjacencyList);
-            //std::cout << "** " << kruskal.getDuration() << " ** " << endl;
-            averageDuration += kruskal.getDuration();
+            // bad edges per recursion level separated by '|'
+            for (size_t depth = 0; depth < statistics[i].badEdgesPerLevel.size(); ++depth) {
+                csv << (depth ? "|" : "") << statistics[i].badEdgesPerLevel[depth];
+            }
+            csv << '\n';
         }
+    }
+}
 
-        averageDuration = averageDuration / (double)iterationNumber;
+// runs each chosen engine on graphs of all sizes and writes statistics of the measured times
+// every graph is generated once and all engines are run on it, each engine is warmed up and then run several times
+void compareEngines(const mstbench::Options& options, const vector<uint32_t>& seed) {
+
+    auto engines = mstbench::selectEngines(options.algorithms);
+    const auto& timing = options.timing;
+
+    // an input graph is loaded once and is the only graph
+    std::unique_ptr<mstio::GraphFile> input;
+    if (!options.input.empty()) input = std::make_unique<mstio::GraphFile>(options.input, options.inputFormat, options.verifyInput);
+    auto inputSize = input ? vector<int>{ static_cast<int>(input->view().nodesNumber()) } : options.inputSizes();
+    const auto graphSeeds = input ? vector<uint32_t>{ 0 } : seed;
+
+    std::ofstream csv(options.outputPath());
+    if (!csv) throw std::runtime_error("can't open " + options.outputPath());
+    // ms is the mean, it's kept first for the plotting script
+    // ms, median, p10 and p90 are of all measured times, the run* columns are the spread of the repetitions within each graph
+    // (Timing.hpp, summarizeGraphs), so the differences between the graph seeds don't count as noise
+    // the phases, the hardware counters, allocated bytes and allocations are means of all samples, the peaks are maximums
+    csv << "algo;n;ms;median;p10;p90;runStddev;runCiLow;runCiHigh;samples;runOutliers;noisy;conversion;preprocessing;core;materialization";
+    csv << ";allocatedBytes;allocations;peakLiveBytes;peakRss";
+    for (size_t event = 0; event < mstbench::perfEventsNumber; ++event) {
+        csv << ';' << mstbench::perfEventName(event);
+    }
+    csv << '\n'; // header
 
-        csv << "Kruskal" << ';' << n << ';' << averageDuration << '\n';
+    mstbench::PerfCounters counters;
+    const bool perf = options.perf && counters.available();
+    if (options.perf && !perf) {
+        MST_LOG(Warning, "hardware counters are not available, their columns stay empty");
     }
 
     for (auto n : inputSize) {
-        //cout << "Current n: " << n << endl;
-
-        double averageDuration = 0;
-        if (n > 5000) break;
-
-        for (int iter = 0; iter < iterationNumber; ++iter) {
-            auto adjacencyList = generateGraph(n, seed[iter]);
-            BoruvkaAlgorithm boruvka(adjacencyList);
-            //std::cout << "** " << boruvka.getDuration() << " ** " << endl;
-            averageDuration += boruvka.getDuration();
+        // slow engines are not run on big graphs
+        vector<mstbench::Engine> active;
+        for (const auto& engine : engines) {
+            if (options.noLimits || !engine.maxN || static_cast<size_t>(n) <= engine.maxN) active.push_back(engine);
+        }
+        if (active.empty()) continue;
+
+        // samples[engine][graph], the times of every graph are summarized on their own scale
+        vector<vector<vector<double>>> samples(active.size(), vector<vector<double>>(graphSeeds.size()));
+        vector<PhaseTimes> phases(active.size());
+        // sum of the counter values, the event is valid only if it's been counted in all runs
+        vector<mstbench::PerfValues> perfValues(active.size());
+        for (auto& values : perfValues) values.valid.fill(perf);
+        vector<mstbench::MemoryStats> memory(active.size());
+        mstbench::MemoryScope memoryScope;
+
+        // engines with runView use the input graph in place, the adjacency list is built only if another engine needs it
+        mstgen::CSRView inputView = input ? input->view() : mstgen::CSRView{};
+        const bool needsList = !input || std::any_of(active.begin(), active.end(), [](const mstbench::Engine& engine) { return !engine.runView; });
+        auto runEngine = [&](size_t i, mstgen::AdjList& adjacencyList, MSTResult<>* mst, const mstbench::RunHooks* hooks) {
+            return input && active[i].runView ? active[i].runView(inputView, mst, hooks)
+                : mstbench::runOnSharedGraph(active[i], adjacencyList, mst, hooks);
+        };
+
+        // the memory and the counters are measured around prepare and solve, like the time, so the copies of the graph are not counted
+        // the counters are stopped first, so reading of the memory usage is not counted
+        mstbench::MemoryStats memoryStats{};
+        mstbench::PerfValues runPerf{};
+        const mstbench::RunHooks hooks{
+            [&] {
+                memoryScope.start();
+                if (perf) counters.start();
+            },
+            [&] {
+                if (perf) runPerf = counters.stop();
+                memoryStats = memoryScope.stop();
+            }
+        };
+
+        for (size_t iter = 0; iter < graphSeeds.size(); ++iter) {
+            auto adjacencyList = !input ? generateGraph(n, graphSeeds[iter], options.model)
+                : needsList ? mstgen::to_adjacency_list(inputView) : mstgen::AdjList{};
+
+            for (size_t i = 0; i < active.size(); ++i) {
+                for (int run = 0; run < timing.warmup; ++run) {
+                    runEngine(i, adjacencyList, nullptr, nullptr);
+                }
+                for (int run = 0; run < timing.repetitions; ++run) {
+                    auto result = runEngine(i, adjacencyList, nullptr, &hooks);
+
+                    if (perf) {
+                        for (size_t event = 0; event < mstbench::perfEventsNumber; ++event) {
+                            perfValues[i].values[event] += runPerf.values[event];
+                            perfValues[i].valid[event] = perfValues[i].valid[event] && runPerf.valid[event];
+                        }
+                    }
+
+                    memory[i].allocatedBytes += memoryStats.allocatedBytes;
+                    memory[i].allocations += memoryStats.allocations;
+                    memory[i].peakLiveBytes = max(memory[i].peakLiveBytes, memoryStats.peakLiveBytes);
+                    memory[i].peakRss = max(memory[i].peakRss, memoryStats.peakRss);
+
+                    samples[i][iter].push_back(result.ms);
+                    MST_LOG(Debug, active[i].name << ": " << result.weight);
+
+                    phases[i].conversion += result.phases.conversion;
+                    phases[i].preprocessing += result.phases.preprocessing;
+                    phases[i].core += result.phases.core;
+                    phases[i].materialization += result.phases.materialization;
+                }
+
+                // the result is taken in one more run, so the copy doesn't change the measurements
+                if (!options.mstOutput.empty() && iter == 0) {
+                    MSTResult<> mst;
+                    runEngine(i, adjacencyList, &mst, nullptr);
+                    mstio::write_mst_result(withSuffix(options.mstOutput, active[i].name + '-' + std::to_string(n)), mst);
+                }
+            }
         }
 
-        averageDuration = averageDuration / (double)iterationNumber;
-
-        csv << "Boruvka" << ';' << n << ';' << averageDuration << '\n';
+        for (size_t i = 0; i < active.size(); ++i) {
+            auto summary = mstbench::summarizeGraphs(samples[i], timing);
+            const double runs = static_cast<double>(summary.samples);
+
+            csv << active[i].name << ';' << n << ';' << summary.mean << ';' << summary.median << ';'
+                << summary.p10 << ';' << summary.p90 << ';' << summary.stddev << ';'
+                << summary.ciLow << ';' << summary.ciHigh << ';' << summary.samples << ';'
+                << summary.outliers << ';' << (summary.noisy ? 1 : 0) << ';'
+                << phases[i].conversion / runs << ';' << phases[i].preprocessing / runs << ';'
+                << phases[i].core / runs << ';' << phases[i].materialization / runs << ';'
+                << static_cast<size_t>(memory[i].allocatedBytes / runs) << ';' << static_cast<size_t>(memory[i].allocations / runs) << ';'
+                << memory[i].peakLiveBytes << ';' << memory[i].peakRss;
+
+            for (size_t event = 0; event < mstbench::perfEventsNumber; ++event) {
+                csv << ';';
+                if (perfValues[i].valid[event]) csv << perfValues[i].values[event] / runs;
+            }
+            csv << '\n';
+
+            if (summary.noisy) {
+                MST_LOG(Warning, "noisy result: " << active[i].name << " n=" << n << " median=" << summary.median
+                    << " ci=[" << summary.ciLow << ", " << summary.ciHigh << "] outliers=" << summary.outliers);
+            }
+        }
+        csv.flush();
     }
+}
 
-    for (auto n : inputSize) {
-        //cout << "Current n: " << n << endl;
+// runs the chosen engines on the worst-case input of every engine, so the tail latencies can be compared with benchDense.csv
+// results of each family are written to the output path with the family name appended, e.g. adversarial-prim-worst.csv
+void runAdversarialProfile(const mstbench::Options& options, const vector<uint32_t>& seed) {
 
-        double averageDuration = 0;
-        if (n > 500) break;
+    const string path = options.outputPath();
 
-        for (int iter = 0; iter < iterationNumber; ++iter) {
-            auto adjacencyList = generateGraph(n, seed[iter]);
-            ReverseDeleteAlgorithm reverseDelete(adjacencyList);
-            //std::cout << "** " << boruvka.getDuration() << " ** " << endl;
-            averageDuration += reverseDelete.getDuration();
-        }
+    for (auto family : mstgen::graph_families()) {
+        if (!mstgen::is_adversarial(family)) continue;
 
-        averageDuration = averageDuration / (double)iterationNumber;
+        auto familyOptions = options;
+        familyOptions.model.family = family;
+        familyOptions.sizes = options.inputSizes({ 500, 1000, 2000 });
+        familyOptions.output = withSuffix(path, mstgen::graph_family_name(family));
+        if (!options.mstOutput.empty()) familyOptions.mstOutput = withSuffix(options.mstOutput, mstgen::graph_family_name(family));
 
-        csv << "ReverseDelete" << ';' << n << ';' << averageDuration << '\n';
+        MST_LOG(Info, "family " << mstgen::graph_family_name(family) << " -> " << familyOptions.output);
+        compareEngines(familyOptions, seed);
     }
+}
 
-    for (auto n : inputSize) {
-        //cout << "Current n: " << n << endl;
+// runs the streaming engines on the input edge file, every run reads the file again
+void compareStreamEngines(const mstbench::Options& options) {
+
+    auto engines = mstbench::selectStreamEngines(options.algorithms);
+    const auto& timing = options.timing;
 
-        double averageDuration = 0;
-        if (n > 5000) break;
+    std::ofstream csv(options.outputPath());
+    if (!csv) throw std::runtime_error("can't open " + options.outputPath());
+    csv << "algo;n;ms;median;p10;p90;stddev;ciLow;ciHigh;samples;outliers;noisy;conversion;preprocessing;core;materialization;peakRss\n";
 
-        for (int iter = 0; iter < iterationNumber; ++iter) {
-            auto adjacencyList = generateGraph(n, seed[iter]);
-            KargerAlgorithm karger(adjacencyList);
-            //std::cout << "** " << karger.getDuration() << " ** " << endl;
-            averageDuration += karger.getDuration();
+    mstbench::MemoryScope memoryScope;
+    for (const auto& engine : engines) {
+        for (int run = 0; run < timing.warmup; ++run) {
+            engine.run(options.input, options.stream, nullptr);
         }
 
-        averageDuration = averageDuration / (double)iterationNumber;
+        vector<double> samples;
+        PhaseTimes phases{};
+        size_t nodes = 0, peakRss = 0;
+        for (int run = 0; run < timing.repetitions; ++run) {
+            memoryScope.start();
+            auto result = engine.run(options.input, options.stream, nullptr);
+            peakRss = max(peakRss, memoryScope.stop().peakRss);
+
+            samples.push_back(result.ms);
+            nodes = result.nodes;
+            phases.conversion += result.phases.conversion;
+            phases.preprocessing += result.phases.preprocessing;
+            phases.core += result.phases.core;
+            phases.materialization += result.phases.materialization;
+        }
 
-        csv << "Karger" << ';' << n << ';' << averageDuration << '\n';
+        auto summary = mstbench::summarize(samples, timing);
+        const double runs = static_cast<double>(samples.size());
+        csv << engine.name << ';' << nodes << ';' << summary.mean << ';' << summary.median << ';'
+            << summary.p10 << ';' << summary.p90 << ';' << summary.stddev << ';'
+            << summary.ciLow << ';' << summary.ciHigh << ';' << summary.samples << ';'
+            << summary.outliers << ';' << (summary.noisy ? 1 : 0) << ';'
+            << phases.conversion / runs << ';' << phases.preprocessing / runs << ';'
+            << phases.core / runs << ';' << phases.materialization / runs << ';' << peakRss << '\n';
+
+        if (!options.mstOutput.empty()) {
+            MSTResult<> mst;
+            engine.run(options.input, options.stream, &mst);
+            mstio::write_mst_result(withSuffix(options.mstOutput, engine.name + '-' + std::to_string(nodes)), mst);
+        }
     }
+}
 
-    for (auto n : inputSize) {
-        //cout << "Current n: " << n << endl;
-
-        double averageDuration = 0;
-        if (n > 5000) break;
-
-        for (int iter = 0; iter < iterationNumber; ++iter) {
-            auto adjacencyList = generateGraph(n, seed[iter]);
-            FredmanTarjan fredmanTarjan(adjacencyList);
-            //std::cout << "** " << fredmanTarjan.getDuration() << " ** " << endl;
-            averageDuration += fredmanTarjan.getDuration();
-        }
+// writes the input graph (a text graph, or a binary one to verify or upgrade it) or the generated graph of the first size and seed
+// to a binary graph file, or to an edge stream when the output ends with .mste
+void convertGraph(const mstbench::Options& options, const vector<uint32_t>& seed) {
 
-        averageDuration = averageDuration / (double)iterationNumber;
+    const string path = options.outputPath();
 
-        csv << "FredmanTarjan" << ';' << n << ';' << averageDuration << '\n';
+    if (!options.input.empty()) {
+        mstio::GraphFile input(options.input, options.inputFormat, options.verifyInput);
+        if (mstio::is_edge_stream_path(path)) mstio::write_edge_stream(path, input.view());
+        else mstio::write_binary_graph(path, input.view());
+        MST_LOG(Info, options.input << " -> " << path);
+        return;
     }
 
-    for (auto n : inputSize) {
-        //cout << "Current n: " << n << endl;
-
-        double averageDuration = 0;
-        if (n > 5000) break;
-
-        for (int iter = 0; iter < iterationNumber; ++iter) {
-            auto adjacencyList = generateGraph(n, seed[iter]);
-            Chazelle chazelle(adjacencyList);
-            //std::cout << "** " << chazelle.getDuration() << " ** " << endl;
-            averageDuration += chazelle.getDuration();
-        }
+    const size_t n = static_cast<size_t>(options.inputSizes().front());
+    auto g = mstgen::make_family_csr(options.model.family, n, options.model.densityFor(n), seed.front(), options.model.weights);
+    if (mstio::is_edge_stream_path(path)) mstio::write_edge_stream(path, mstgen::view(g));
+    else mstio::write_binary_graph(path, g);
+    MST_LOG(Info, mstgen::graph_family_name(options.model.family) << " V=" << g.nodesNumber() << " E=" << g.edgesNumber() << " -> " << path);
+}
 
-        averageDuration = averageDuration / (double)iterationNumber;
+int main(int argc, char** argv) {
 
-        csv << "Chazelle" << ';' << n << ';' << averageDuration << '\n';
+    mstbench::Options options;
+    try {
+        options = mstbench::parseOptions(argc, argv);
+    }
+    catch (const std::invalid_argument& e) {
+        std::cerr << e.what() << '\n' << mstbench::usage();
+        return 1;
     }
 
-    /*PrimsAlgorithm prim(adjacencyList);
-    KruskalAlgorithm kruskal(adjacencyList);
-    BoruvkaAlgorithm boruvka(adjacencyList);
-    ReverseDeleteAlgorithm deleteReverse(adjacencyList);
-    KargerAlgorithm karger(adjacencyList);
-    FredmanTarjan fredmanTarjan(adjacencyList);
-    Chazelle chazelle(adjacencyList);*/
+    if (options.help) {
+        std::cout << mstbench::usage();
+        return 0;
+    }
+    setLogLevel(options.logLevel);
+
+    vector<uint32_t> seed = options.seeds.empty() ? createSeed(options.iterations, options.seed) : options.seeds;
+
+    try {
+        switch (options.mode) {
+        case mstbench::Mode::ChazelleEpsilon:
+            // finds the soft heap error rate for Chazelle
+            tuneChazelleEpsilon(options.inputSizes({ 500, 1000, 2000 }), options.epsilons, seed, options.model, options.outputPath());
+            break;
+        case mstbench::Mode::SoftHeap:
+            // compares soft heap selection and queue with the standard library
+            softheapbench::benchSoftHeap(options.inputSizes({ 1000, 10000, 100000, 1000000 }), seed, options.outputPath());
+            break;
+        case mstbench::Mode::Adversarial:
+            runAdversarialProfile(options, seed);
+            break;
+        case mstbench::Mode::Convert:
+            convertGraph(options, seed);
+            break;
+        case mstbench::Mode::Stream:
+            compareStreamEngines(options);
+            break;
+        default:
+            compareEngines(options, seed);
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
 
 	return 0;
-}
\ No newline at end of file
+}